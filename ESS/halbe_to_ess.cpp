@@ -2161,6 +2161,11 @@ void HAL2ESS::write_playback_pulses(Handle::FPGA const& f, FPGA::PulseEventConta
 	}
 }
 
+void HAL2ESS::write_playback_program(Handle::FPGA const& f, FPGA::PlaybackProgram const& program)
+{
+	write_playback_pulses(f, program.events(), program.runtime(), program.fpga_hicann_delay());
+}
+
 void HAL2ESS::start_experiment(Handle::FPGA const& f)
 {
 	size_t fpga_id = f.coordinate().value();
@@ -2175,7 +2180,12 @@ bool HAL2ESS::get_pbmem_buffering_completed(Handle::FPGA & /*f*/)
 
 //returns the PulseEventContainer with the Events that where read out during the simulation
 //call after the simulation has run!!
-FPGA::AlmostSortedPulseEvents HAL2ESS::read_trace_pulses(Handle::FPGA const& f, FPGA::PulseEvent::spiketime_t /*runtime*/, bool drop_background_events)
+FPGA::AlmostSortedPulseEvents HAL2ESS::read_trace_pulses(Handle::FPGA const& f, FPGA::PulseEvent::spiketime_t runtime, bool drop_background_events)
+{
+	return read_trace_pulses(f, runtime, FPGA::background_filter(drop_background_events));
+}
+
+FPGA::AlmostSortedPulseEvents HAL2ESS::read_trace_pulses(Handle::FPGA const& f, FPGA::PulseEvent::spiketime_t /*runtime*/, FPGA::TraceEventFilter const& filter)
 {
 	size_t fpga_id = f.coordinate().value();
 	mvirtual_hw->pcb_i.at(0)->get_fpga(fpga_id)->setStopTrace(true);
@@ -2190,11 +2200,6 @@ FPGA::AlmostSortedPulseEvents HAL2ESS::read_trace_pulses(Handle::FPGA const& f,
 			auto fpga_time = pulse.fpga_time;
 			auto pulse_event = pulse.event;
 
-			if (drop_background_events && pulse_event.getNeuronAddress().value() == 0) {
-				++dropped_events;
-				continue;
-			}
-
 			auto time_stamp = pulse_event.getTime();
 			// compute overflow count from fpga time
 			uint64_t fpga_time_in_dnc_clk = 2*fpga_time;
@@ -2203,6 +2208,10 @@ FPGA::AlmostSortedPulseEvents HAL2ESS::read_trace_pulses(Handle::FPGA const& f,
 			if ( (fpga_time_in_dnc_clk % dnc_cycle_length) < time_stamp )
 				--overflow_count;
 			pulse_event.setTime( time_stamp + overflow_count*dnc_cycle_length);
+			if (!filter.accepts(pulse_event)) {
+				++dropped_events;
+				continue;
+			}
 			rv.push_back(pulse_event);
 		}
 	}
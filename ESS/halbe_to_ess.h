@@ -13,6 +13,8 @@
 //HALbe datatypes
 #include "hal/DNCContainer.h"
 #include "hal/FPGAContainer.h"
+#include "hal/FPGA/PlaybackProgram.h"
+#include "hal/FPGA/TraceEventFilter.h"
 #include "hal/HMFUtil.h"
 #include "hal/Coordinate/HMFGeometry.h"
 #include "hal/HICANNContainer.h"
@@ -242,8 +244,10 @@ public:
     void reset(Handle::FPGA const&);
     void set_fpga_background_generator(Handle::FPGA const& f, Coordinate::DNCOnFPGA const d, FPGA::BackgroundGenerator const& bg);
     void write_playback_pulses(Handle::FPGA const& f, FPGA::PulseEventContainer const& st, FPGA::PulseEvent::spiketime_t runtime, uint16_t fpga_hicann_delay);
+    void write_playback_program(Handle::FPGA const& f, FPGA::PlaybackProgram const& program);
 	bool get_pbmem_buffering_completed(Handle::FPGA & f);
 	FPGA::AlmostSortedPulseEvents read_trace_pulses(Handle::FPGA const& f, FPGA::PulseEvent::spiketime_t runtime, bool drop_background_events = false);
+	FPGA::AlmostSortedPulseEvents read_trace_pulses(Handle::FPGA const& f, FPGA::PulseEvent::spiketime_t runtime, FPGA::TraceEventFilter const& filter);
     //dummy implementetions, not needed for ESS afaik
     void reset(Handle::FPGA const&, FPGA::Reset const&){ESS_DUMMY();}
     void reset_pbmem(Handle::FPGA const&){ESS_DUMMY();}
@@ -0,0 +1,129 @@
+#include "bench/PulseDataHelper.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "hal/backend/TraceDecoder.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+namespace {
+
+// All inputs are generated with fixed seeds, results of different runs and
+// hosts are comparable.
+std::uint64_t const seed = 1234;
+
+std::uint32_t pulse_entry(std::uint32_t const label, PulseEvent::spiketime_t const time)
+{
+	std::uint32_t const timestamp = time % TraceDecoder::max_timestamp_count;
+	std::uint32_t const msb = timestamp >> (TraceDecoder::event_timestamp_bits - 1);
+	return (msb << 29) | ((label & 0xfff) << TraceDecoder::event_timestamp_bits) | timestamp;
+}
+
+std::uint32_t overflow_entry(std::uint64_t const count)
+{
+	return (1u << 31) | static_cast<std::uint32_t>(count & 0x7fffffff);
+}
+
+std::uint64_t word(std::uint32_t const lower, std::uint32_t const upper)
+{
+	return (static_cast<std::uint64_t>(upper) << 32) | lower;
+}
+
+} // namespace
+
+std::vector<trace_packet_type> generate_trace_corpus(
+	size_t const num_packets, PulseEvent::spiketime_t const mean_isi)
+{
+	std::mt19937_64 rng(seed);
+	// non-zero distances, as the decoder warns about duplicate events
+	std::uniform_int_distribution<PulseEvent::spiketime_t> isi(1, 2 * mean_isi - 1);
+	std::uniform_int_distribution<std::uint32_t> label(0, 0xfff);
+
+	std::vector<trace_packet_type> corpus(num_packets);
+	PulseEvent::spiketime_t time = 0;
+	std::uint64_t overflow_count = 0;
+	for (auto& packet : corpus) {
+		packet.reserve(max_packet_words);
+		while (packet.size() < max_packet_words) {
+			std::uint32_t entries[2];
+			for (size_t ii = 0; ii < 2; ++ii) {
+				time += isi(rng);
+				// overflow indicators are only valid in the upper entry
+				if (ii == 1 && time / TraceDecoder::max_timestamp_count > overflow_count) {
+					entries[ii] = overflow_entry(++overflow_count);
+				} else {
+					entries[ii] = pulse_entry(label(rng), time);
+				}
+			}
+			packet.push_back(word(entries[0], entries[1]));
+		}
+	}
+	corpus.push_back(trace_packet_type(1, TraceDecoder::end_of_trace_marker));
+	return corpus;
+}
+
+PulseEventContainer::container_type generate_almost_sorted_events(
+	size_t const num_events, std::vector<PulseEventContainer::container_type>& per_link)
+{
+	size_t const num_links = 8;
+	size_t const l1_address_bits = 6;
+	// events are late by at most one timestamp window
+	PulseEvent::spiketime_t const max_delay = TraceDecoder::max_timestamp_count;
+	// mean distance of events of the same link in clock cycles
+	PulseEvent::spiketime_t const mean_isi = 128;
+
+	std::mt19937_64 rng(seed);
+	std::uniform_int_distribution<PulseEvent::spiketime_t> isi(0, 2 * mean_isi);
+	std::uniform_int_distribution<PulseEvent::spiketime_t> delay(0, max_delay - 1);
+	std::uniform_int_distribution<PulseAddress::label_t> neuron(0, L1Address::max);
+
+	per_link.assign(num_links, PulseEventContainer::container_type());
+	std::vector<std::pair<PulseEvent::spiketime_t, PulseEvent> > arrivals;
+	arrivals.reserve(num_events);
+	std::vector<PulseEvent::spiketime_t> time(num_links, 0);
+	for (size_t ii = 0; ii < num_events; ++ii) {
+		size_t const link = ii % num_links;
+		time[link] += isi(rng);
+		PulseEvent const event(
+			PulseAddress((link << l1_address_bits) | neuron(rng)), time[link]);
+		per_link[link].push_back(event);
+		arrivals.emplace_back(time[link] + delay(rng), event);
+	}
+
+	std::stable_sort(
+		arrivals.begin(), arrivals.end(),
+		[](std::pair<PulseEvent::spiketime_t, PulseEvent> const& a,
+		   std::pair<PulseEvent::spiketime_t, PulseEvent> const& b) { return a.first < b.first; });
+
+	PulseEventContainer::container_type events;
+	events.reserve(num_events);
+	for (auto const& arrival : arrivals) {
+		events.push_back(arrival.second);
+	}
+	return events;
+}
+
+PulseEventContainer generate_playback_events(size_t const num_events)
+{
+	std::mt19937_64 rng(seed);
+	// about one pulse every 4 FPGA cycles, which the playback can release in time
+	std::uniform_int_distribution<PulseEvent::spiketime_t> isi(0, 16);
+	std::uniform_int_distribution<PulseAddress::label_t> label(0, PulseAddress::num_labels - 1);
+
+	PulseEventContainer::container_type events;
+	events.reserve(num_events);
+	PulseEvent::spiketime_t time = 80;
+	for (size_t ii = 0; ii < num_events; ++ii) {
+		time += isi(rng);
+		events.push_back(PulseEvent(PulseAddress(label(rng)), time));
+	}
+	return PulseEventContainer(std::move(events));
+}
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+/// Payload of one FPGATRACE packet (sctrltp::packet::pdu).
+typedef std::vector<std::uint64_t> trace_packet_type;
+
+/// Maximum number of 64 bit words per HostARQ packet.
+static const size_t max_packet_words = 176;
+
+/**
+ * @brief Trace packets as sent by the FPGA, with overflow indicators in
+ *        place and terminated by the end-of-trace marker.
+ *
+ * @param num_packets Number of full packets.
+ * @param mean_isi Mean distance of consecutive pulse events in DNC cycles.
+ */
+std::vector<trace_packet_type> generate_trace_corpus(
+	size_t num_packets, PulseEvent::spiketime_t mean_isi = 4);
+
+/**
+ * @brief Per-link sorted pulse events, interleaved in order of arrival with a
+ *        bounded random delay, as read out from the trace memory.
+ * @param per_link Set to the events of each of the 8 links in time order.
+ */
+PulseEventContainer::container_type generate_almost_sorted_events(
+	size_t num_events, std::vector<PulseEventContainer::container_type>& per_link);
+
+/**
+ * @brief Sorted pulse events of random labels, valid for the playback with
+ *        the default fpga_hicann_delay.
+ */
+PulseEventContainer generate_playback_events(size_t num_events);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
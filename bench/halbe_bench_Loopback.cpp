@@ -0,0 +1,36 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/PulseDataHelper.h"
+#include "hal/backend/FPGABackend.h"
+#include "hal/backend/LoopbackTransport.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+/// Full write_playback_pulses -> read_trace_pulses cycle via the loopback transport.
+void BM_Loopback_PlaybackTrace(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	PulseEvent::spiketime_t const runtime = events[events.size() - 1].getTime() + 1000;
+
+	LoopbackTransport::Config config;
+	config.latency = std::chrono::microseconds(0);
+	config.reorder_probability = 0.01;
+	LoopbackTransport transport(config);
+
+	for (auto _ : state) {
+		write_playback_pulses(transport, events, runtime);
+		auto const trace =
+			read_trace_pulses(transport, Coordinate::FPGAGlobal(), runtime, TraceEventFilter());
+		PulseEventContainer const sorted(trace);
+		benchmark::DoNotOptimize(sorted.data().data());
+	}
+	state.SetItemsProcessed(state.iterations() * events.size());
+	state.counters["packets"] = transport.trace_packets();
+}
+BENCHMARK(BM_Loopback_PlaybackTrace)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/PulseDataHelper.h"
+#include "hal/FPGA/PlaybackAnalyzer.h"
+#include "hal/FPGA/PlaybackProgram.h"
+#include "hal/FPGA/PlaybackPulses.h"
+#include "hal/FPGA/ReleaseLimit.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+namespace {
+
+std::uint16_t const fpga_hicann_delay = 40;
+
+PulseEvent::spiketime_t runtime(PulseEventContainer const& events)
+{
+	return events[events.size() - 1].getTime() + 1000;
+}
+
+} // namespace
+
+void BM_PlaybackPulseEncoder(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	PlaybackPulseEncoder encoder;
+	for (auto _ : state) {
+		encoder.encode(events, runtime(events), fpga_hicann_delay);
+		benchmark::DoNotOptimize(encoder.pulses().data());
+	}
+	state.SetItemsProcessed(state.iterations() * events.size());
+	state.SetBytesProcessed(state.iterations() * events.size() * sizeof(PlaybackPulse));
+}
+BENCHMARK(BM_PlaybackPulseEncoder)->Arg(1 << 16)->Arg(1 << 20);
+
+void BM_PlaybackProgram(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	for (auto _ : state) {
+		PlaybackProgram const program(events, runtime(events), fpga_hicann_delay);
+		benchmark::DoNotOptimize(program.pulses().data());
+	}
+	state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_PlaybackProgram)->Arg(1 << 20);
+
+void BM_ReleaseLimit(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	ReleaseLimit const limit(fpga_hicann_delay);
+	size_t dropped_events = 0;
+	for (auto _ : state) {
+		PulseEventContainer const released = limit.apply(events, dropped_events);
+		benchmark::DoNotOptimize(released.data().data());
+	}
+	state.SetItemsProcessed(state.iterations() * events.size());
+	state.counters["dropped"] = dropped_events;
+}
+BENCHMARK(BM_ReleaseLimit)->Arg(1 << 20);
+
+void BM_PlaybackAnalyzer(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	PlaybackAnalyzer const analyzer(ReleaseLimit{fpga_hicann_delay});
+	for (auto _ : state) {
+		PlaybackLoad const load = analyzer.analyze(events);
+		benchmark::DoNotOptimize(load.peak_pulses);
+	}
+	state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_PlaybackAnalyzer)->Arg(1 << 20);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
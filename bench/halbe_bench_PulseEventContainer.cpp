@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include "bench/PulseDataHelper.h"
+#include "hal/FPGA/PulseEventPartition.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+namespace {
+
+typedef PulseEventContainer::container_type container_type;
+
+void set_processed(benchmark::State& state, size_t const num_events)
+{
+	state.SetItemsProcessed(state.iterations() * num_events);
+	state.SetBytesProcessed(state.iterations() * num_events * sizeof(PulseEvent));
+}
+
+} // namespace
+
+/// Bounded-disorder sort of the events as read out from the trace memory.
+void BM_PulseEventContainer_AlmostSorted(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	container_type const events = generate_almost_sorted_events(state.range(0), per_link);
+	for (auto _ : state) {
+		state.PauseTiming();
+		container_type data(events);
+		state.ResumeTiming();
+		PulseEventContainer const container(std::move(data), true);
+		benchmark::DoNotOptimize(container.data().data());
+	}
+	set_processed(state, events.size());
+}
+BENCHMARK(BM_PulseEventContainer_AlmostSorted)->Arg(1 << 16)->Arg(1 << 20);
+
+/// Generic sort, for comparison.
+void BM_PulseEventContainer_Sort(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	container_type const events = generate_almost_sorted_events(state.range(0), per_link);
+	for (auto _ : state) {
+		state.PauseTiming();
+		container_type data(events);
+		state.ResumeTiming();
+		PulseEventContainer const container(std::move(data), false);
+		benchmark::DoNotOptimize(container.data().data());
+	}
+	set_processed(state, events.size());
+}
+BENCHMARK(BM_PulseEventContainer_Sort)->Arg(1 << 16)->Arg(1 << 20);
+
+/// Previously used insertion sort, quadratic in the disorder.
+void BM_PulseEventContainer_InsertionSort(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	container_type const events = generate_almost_sorted_events(state.range(0), per_link);
+	for (auto _ : state) {
+		state.PauseTiming();
+		container_type data(events);
+		state.ResumeTiming();
+		for (auto it = data.begin(); it != data.end(); ++it) {
+			std::rotate(std::upper_bound(data.begin(), it, *it), it, std::next(it));
+		}
+		benchmark::DoNotOptimize(data.data());
+	}
+	set_processed(state, events.size());
+}
+BENCHMARK(BM_PulseEventContainer_InsertionSort)->Arg(1 << 16);
+
+/// k-way merge of the per-link sorted events.
+void BM_PulseEventContainer_MergeLinks(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	size_t const num_events = generate_almost_sorted_events(state.range(0), per_link).size();
+	for (auto _ : state) {
+		PulseEventContainer const container(per_link);
+		benchmark::DoNotOptimize(container.data().data());
+	}
+	set_processed(state, num_events);
+}
+BENCHMARK(BM_PulseEventContainer_MergeLinks)->Arg(1 << 16)->Arg(1 << 20);
+
+/// Merge of two sorted containers of equal size.
+void BM_PulseEventContainer_Merge(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	generate_almost_sorted_events(state.range(0), per_link);
+	container_type even, odd;
+	for (size_t link = 0; link < per_link.size(); ++link) {
+		auto& target = (link % 2) ? odd : even;
+		target.insert(target.end(), per_link[link].begin(), per_link[link].end());
+	}
+	PulseEventContainer const first(std::move(even));
+	PulseEventContainer const second(std::move(odd));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		PulseEventContainer container(first);
+		state.ResumeTiming();
+		container.merge(second);
+		benchmark::DoNotOptimize(container.data().data());
+	}
+	set_processed(state, first.size() + second.size());
+}
+BENCHMARK(BM_PulseEventContainer_Merge)->Arg(1 << 16)->Arg(1 << 20);
+
+/// Lazy label index construction and lookup of all labels.
+void BM_PulseEventContainer_LabelIndex(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	PulseEventContainer const events(generate_almost_sorted_events(state.range(0), per_link), true);
+	for (auto _ : state) {
+		state.PauseTiming();
+		PulseEventContainer container(events);
+		state.ResumeTiming();
+		size_t num_positions = 0;
+		for (size_t label = 0; label < PulseAddress::num_labels; ++label) {
+			auto const positions = container.positions_of(label);
+			num_positions += positions.second - positions.first;
+		}
+		benchmark::DoNotOptimize(num_positions);
+	}
+	set_processed(state, events.size());
+}
+BENCHMARK(BM_PulseEventContainer_LabelIndex)->Arg(1 << 16)->Arg(1 << 20);
+
+void BM_PulseEventPartition(benchmark::State& state)
+{
+	std::vector<container_type> per_link;
+	PulseEventContainer const events(generate_almost_sorted_events(state.range(0), per_link), true);
+	for (auto _ : state) {
+		PulseEventPartition const partition(events, PulseEventPartition::Prefix::chip);
+		benchmark::DoNotOptimize(partition.data().data());
+	}
+	set_processed(state, events.size());
+}
+BENCHMARK(BM_PulseEventPartition)->Arg(1 << 16)->Arg(1 << 20);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
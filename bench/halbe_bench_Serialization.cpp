@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <sstream>
+#include <unistd.h>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "bench/PulseDataHelper.h"
+#include "hal/FPGA/PlaybackProgram.h"
+#include "hal/FPGA/PulseEventColumns.h"
+#include "hal/FPGA/SpikeFile.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+namespace {
+
+/// Saves and loads @a object to a binary archive in memory.
+template <typename T>
+void round_trip(benchmark::State& state, T const& object, size_t const num_events)
+{
+	size_t archive_size = 0;
+	for (auto _ : state) {
+		std::stringstream stream;
+		{
+			boost::archive::binary_oarchive oa(stream);
+			oa << object;
+		}
+		archive_size = stream.tellp();
+		T loaded;
+		{
+			boost::archive::binary_iarchive ia(stream);
+			ia >> loaded;
+		}
+		benchmark::DoNotOptimize(loaded);
+	}
+	state.SetItemsProcessed(state.iterations() * num_events);
+	state.SetBytesProcessed(state.iterations() * archive_size);
+	state.counters["archive_bytes"] = archive_size;
+}
+
+} // namespace
+
+void BM_Serialization_PulseEventContainer(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	round_trip(state, events, events.size());
+}
+BENCHMARK(BM_Serialization_PulseEventContainer)->Arg(1 << 20);
+
+void BM_Serialization_PulseEventColumns(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	PulseEventColumns const columns(events, PulseEventColumns::TimeEncoding::delta);
+	round_trip(state, columns, events.size());
+}
+BENCHMARK(BM_Serialization_PulseEventColumns)->Arg(1 << 20);
+
+void BM_Serialization_PlaybackProgram(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+	PlaybackProgram const program(events, events[events.size() - 1].getTime() + 1000);
+	round_trip(state, program, events.size());
+}
+BENCHMARK(BM_Serialization_PlaybackProgram)->Arg(1 << 20);
+
+/// Writing and mapping a spike file, including reading all events.
+void BM_Serialization_SpikeFile(benchmark::State& state)
+{
+	PulseEventContainer const events = generate_playback_events(state.range(0));
+
+	char filename[] = "/tmp/halbe_bench_SpikeFileXXXXXX";
+	int const fd = mkstemp(filename);
+	if (fd == -1) {
+		state.SkipWithError("could not create temporary file");
+		return;
+	}
+	close(fd);
+
+	for (auto _ : state) {
+		SpikeFileWriter::write(filename, events);
+		SpikeFile const file(filename);
+		PulseEventContainer const loaded = file.container();
+		benchmark::DoNotOptimize(loaded.data().data());
+	}
+	std::remove(filename);
+	state.SetItemsProcessed(state.iterations() * events.size());
+	state.SetBytesProcessed(state.iterations() * events.size() * sizeof(SpikeFileRecord));
+}
+BENCHMARK(BM_Serialization_SpikeFile)->Arg(1 << 20);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,147 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "hal/Coordinate/iter_all.h"
+#include "hal/backend/HICANNBackendHelper.h"
+
+namespace HMF {
+namespace HICANN {
+namespace bench {
+
+namespace {
+
+typedef std::array<std::bitset<32>, 32> words_t;
+
+std::mt19937& rng()
+{
+	static std::mt19937 engine(1234);
+	return engine;
+}
+
+template <typename T>
+std::array<T, 256> random_row()
+{
+	std::uniform_int_distribution<int> dist(0, 15);
+	std::array<T, 256> returnvalue;
+	for (auto& v : returnvalue)
+		v = T(dist(rng()));
+	return returnvalue;
+}
+
+/// Random configuration of all synapses of a HICANN.
+struct SynapseArray
+{
+	SynapseArray()
+	{
+		for (size_t i = 0; i < Coordinate::SynapseDriverOnHICANN::size; i++) {
+			DecoderDoubleRow row;
+			row[0] = random_row<SynapseDecoder>();
+			row[1] = random_row<SynapseDecoder>();
+			decoders.push_back(row);
+		}
+		for (size_t i = 0; i < Coordinate::SynapseRowOnHICANN::size; i++)
+			weights.push_back(random_row<SynapseWeight>());
+	}
+
+	std::vector<DecoderDoubleRow> decoders;
+	std::vector<WeightRow> weights;
+};
+
+SynapseArray const& synapse_array()
+{
+	static SynapseArray const array;
+	return array;
+}
+
+/// Hardware words of all decoder rows as read back, in pairs of top and bottom row.
+std::vector<std::array<words_t, 2> > const& decoder_words()
+{
+	static std::vector<std::array<words_t, 2> > const words = [] {
+		std::vector<std::array<words_t, 2> > returnvalue;
+		for (auto const& row : synapse_array().decoders) {
+			returnvalue.push_back({{top_to_decoder(row[0], row[1]), bot_to_decoder(row[0], row[1])}});
+		}
+		return returnvalue;
+	}();
+	return words;
+}
+
+} // namespace
+
+/// Formats the synapse controller writes of all decoders of a HICANN.
+void BM_SynapseEncoding_Decoders(benchmark::State& state)
+{
+	auto const& decoders = synapse_array().decoders;
+	size_t num_writes = 0;
+	for (auto _ : state) {
+		num_writes = 0;
+		for (auto drv : Coordinate::iter_all<Coordinate::SynapseDriverOnHICANN>()) {
+			set_decoder_double_row_impl(
+			    drv, decoders[drv.toEnum()], [&num_writes](sc_write_data const& instr) {
+				    benchmark::DoNotOptimize(instr.data);
+				    ++num_writes;
+			    });
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * decoders.size());
+	state.counters["writes"] = num_writes;
+}
+BENCHMARK(BM_SynapseEncoding_Decoders);
+
+/// Formats the synapse controller writes of all weights of a HICANN.
+void BM_SynapseEncoding_Weights(benchmark::State& state)
+{
+	auto const& weights = synapse_array().weights;
+	size_t num_writes = 0;
+	for (auto _ : state) {
+		num_writes = 0;
+		for (auto row : Coordinate::iter_all<Coordinate::SynapseRowOnHICANN>()) {
+			set_weights_row_impl(row, weights[row.toEnum()], [&num_writes](sc_write_data const& instr) {
+				benchmark::DoNotOptimize(instr.data);
+				++num_writes;
+			});
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * weights.size());
+	state.counters["writes"] = num_writes;
+}
+BENCHMARK(BM_SynapseEncoding_Weights);
+
+/// Decodes the read back decoders of a HICANN.
+void BM_SynapseDecoding_Decoders(benchmark::State& state)
+{
+	auto const& words = decoder_words();
+	for (auto _ : state) {
+		for (auto const& w : words) {
+			auto top = top_from_decoder(w[0], w[1]);
+			auto bot = bot_from_decoder(w[0], w[1]);
+			benchmark::DoNotOptimize(top);
+			benchmark::DoNotOptimize(bot);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * words.size());
+}
+BENCHMARK(BM_SynapseDecoding_Decoders);
+
+/// Unpacks the read back weights of a HICANN.
+void BM_SynapseDecoding_Weights(benchmark::State& state)
+{
+	std::vector<words_t> words;
+	for (auto const& row : synapse_array().weights)
+		words.push_back(weights_to_sc_data(row));
+
+	for (auto _ : state) {
+		for (auto const& w : words) {
+			auto weights = weights_row_from_sc_data(w);
+			benchmark::DoNotOptimize(weights);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * words.size());
+}
+BENCHMARK(BM_SynapseDecoding_Weights);
+
+} // namespace bench
+} // namespace HICANN
+} // namespace HMF
@@ -0,0 +1,95 @@
+#include <benchmark/benchmark.h>
+
+#include "bench/PulseDataHelper.h"
+#include "hal/backend/TraceDecoder.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+namespace {
+
+size_t const num_packets = 1 << 12;
+
+std::vector<trace_packet_type> const& corpus()
+{
+	static std::vector<trace_packet_type> const packets = generate_trace_corpus(num_packets);
+	return packets;
+}
+
+void decode_corpus(
+	benchmark::State& state,
+	TraceEventFilter const& filter,
+	TraceDecoder::Implementation const implementation)
+{
+	if (implementation == TraceDecoder::Implementation::avx2 && !TraceDecoder::avx2_supported()) {
+		state.SkipWithError("AVX2 is not supported on this host");
+		return;
+	}
+
+	auto const& packets = corpus();
+	size_t num_words = 0;
+	for (auto const& packet : packets) {
+		num_words += packet.size();
+	}
+
+	size_t num_events = 0;
+	for (auto _ : state) {
+		TraceDecoder decoder(Coordinate::FPGAGlobal(), filter, implementation);
+		num_events = 0;
+		for (auto const& packet : packets) {
+			decoder.decode(packet.data(), packet.size());
+			num_events += decoder.events().size();
+		}
+		benchmark::DoNotOptimize(num_events);
+	}
+	state.SetItemsProcessed(state.iterations() * num_words);
+	state.SetBytesProcessed(state.iterations() * num_words * sizeof(std::uint64_t));
+	state.counters["events"] = num_events;
+}
+
+/// Half of the links and a time window covering about half of the trace.
+TraceEventFilter selective_filter()
+{
+	TraceEventFilter filter;
+	filter.drop_background_events();
+	for (size_t chip = 0; chip < 8; chip += 2) {
+		for (size_t channel = 0; channel < 8; ++channel) {
+			filter.set_link_selected(
+				PulseAddress::chip_address_t(Coordinate::Enum(chip)),
+				PulseAddress::channel_t(Coordinate::Enum(channel)), false);
+		}
+	}
+	filter.set_time_window(0, num_packets * max_packet_words * 4);
+	return filter;
+}
+
+} // namespace
+
+void BM_TraceDecoder_Reference(benchmark::State& state)
+{
+	decode_corpus(state, TraceEventFilter(), TraceDecoder::Implementation::reference);
+}
+BENCHMARK(BM_TraceDecoder_Reference);
+
+void BM_TraceDecoder_AVX2(benchmark::State& state)
+{
+	decode_corpus(state, TraceEventFilter(), TraceDecoder::Implementation::avx2);
+}
+BENCHMARK(BM_TraceDecoder_AVX2);
+
+void BM_TraceDecoder_DropBackground(benchmark::State& state)
+{
+	decode_corpus(state, background_filter(true), TraceDecoder::Implementation::automatic);
+}
+BENCHMARK(BM_TraceDecoder_DropBackground);
+
+void BM_TraceDecoder_Filter(benchmark::State& state)
+{
+	decode_corpus(state, selective_filter(), TraceDecoder::Implementation::automatic);
+}
+BENCHMARK(BM_TraceDecoder_Filter);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
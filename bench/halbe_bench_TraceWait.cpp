@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "bench/PulseDataHelper.h"
+#include "hal/backend/FPGABackend.h"
+#include "hal/backend/LoopbackTransport.h"
+
+namespace HMF {
+namespace FPGA {
+namespace bench {
+
+namespace {
+
+/// Loopback transport counting the polls of the trace readout.
+class PollCountingTransport : public PulseTransport
+{
+public:
+	explicit PollCountingTransport(LoopbackTransport::Config const& config)
+		: m_transport(config), m_polls(0), m_empty_polls(0)
+	{}
+
+	bool upload_playback(
+		PlaybackPulseEncoder::buffer_type const& pulses,
+		std::uint64_t const end_of_experiment_timestamp) override
+	{
+		m_upload = LoopbackTransport::clock_type::now();
+		return m_transport.upload_playback(pulses, end_of_experiment_timestamp);
+	}
+
+	bool receive(sctrltp::packet& packet) override
+	{
+		++m_polls;
+		bool const received = m_transport.receive(packet);
+		if (!received)
+			++m_empty_polls;
+		return received;
+	}
+
+	LoopbackTransport::clock_type::time_point upload() const { return m_upload; }
+	size_t polls() const { return m_polls; }
+	size_t empty_polls() const { return m_empty_polls; }
+
+private:
+	LoopbackTransport m_transport;
+	LoopbackTransport::clock_type::time_point m_upload;
+	size_t m_polls;
+	size_t m_empty_polls;
+};
+
+} // namespace
+
+/**
+ * Trace readout of read_trace_pulses() via a loopback transport recording the
+ * trace in experiment time, state.range(0) is the experiment runtime in us.
+ *
+ * The iteration time is the latency between the end-of-trace marker becoming
+ * available and the return of read_trace_pulses(), the empty polls of the
+ * readout are reported per iteration.
+ */
+void BM_TraceWait_Readout(benchmark::State& state)
+{
+	PulseEvent::spiketime_t const runtime = state.range(0) * DNC_frequency_in_MHz;
+	// about 130 us of pulses, well within the shortest runtime
+	PulseEventContainer const playback = generate_playback_events(1 << 12);
+
+	LoopbackTransport::Config config;
+	config.realtime = true;
+	config.latency = std::chrono::microseconds(200);
+	PollCountingTransport transport(config);
+
+	// end-of-trace marker is available at the end of the experiment, plus latency
+	auto const end_of_trace =
+		config.latency + std::chrono::nanoseconds(runtime * 1000 / DNC_frequency_in_MHz);
+	for (auto _ : state) {
+		write_playback_pulses(transport, playback, runtime);
+		auto const trace =
+			read_trace_pulses(transport, Coordinate::FPGAGlobal(), runtime, TraceEventFilter());
+		auto const latency = LoopbackTransport::clock_type::now() - (transport.upload() + end_of_trace);
+		benchmark::DoNotOptimize(trace.events.data());
+		state.SetIterationTime(std::max(0., std::chrono::duration<double>(latency).count()));
+	}
+	state.counters["empty_polls"] =
+		benchmark::Counter(transport.empty_polls(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_TraceWait_Readout)
+	->Arg(1000)
+	->Arg(10000)
+	->UseManualTime()
+	->Iterations(50)
+	->Unit(benchmark::kMicrosecond);
+
+} // namespace bench
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,13 @@
+// Hardware-free benchmarks of the pulse data path.
+//
+// Usage: halbe_bench [--benchmark_filter=<regex>] [--benchmark_repetitions=<n>]
+//                    [--benchmark_out=<file> --benchmark_out_format=json]
+//
+// All inputs are synthetic with fixed sizes and seeds, hence results of
+// different builds are directly comparable, e.g. by compare.py of Google
+// Benchmark on the JSON output. Throughput is reported in items (pulse events
+// or trace words) and bytes per second.
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
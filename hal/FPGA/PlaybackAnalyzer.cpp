@@ -0,0 +1,145 @@
+#include "hal/FPGA/PlaybackAnalyzer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+std::uint64_t const PlaybackAnalyzer::default_window;
+size_t const PlaybackLoad::num_links;
+size_t const PlaybackAnalyzer::default_bytes_per_pulse;
+
+namespace {
+
+/**
+ * Replays the release of @a events as done by ReleaseLimit: each pulse is
+ * assigned the earliest free FPGA cycle at or after its nominal release time.
+ * @a visit(event, delay) is called with the resulting release delay in FPGA
+ * cycles and returns whether the pulse is released, i.e. occupies the cycle.
+ */
+template <typename Visit>
+void simulate_release(PulseEventContainer const& events, ReleaseLimit const& limit, Visit const& visit)
+{
+	PulseEvent::spiketime_t const earliest = 2 * PulseEvent::spiketime_t(limit.fpga_hicann_delay);
+	if (events.size() && events[0].getTime() < earliest)
+		throw std::runtime_error(
+			"PlaybackAnalyzer: the time of the PulseEvent has to be greater or equal than "
+			"fpga_hicann_delay*2");
+
+	std::int64_t previous = 0;
+	for (auto const& event : events.data()) {
+		std::int64_t const release = event.getTime() / 2 - limit.fpga_hicann_delay;
+		std::int64_t const slot = std::max(release, previous + 1);
+		if (visit(event, slot - release)) {
+			previous = slot;
+		}
+	}
+}
+
+} // namespace
+
+PlaybackAnalyzer::PlaybackAnalyzer(
+	ReleaseLimit const& limit, std::uint64_t const window, size_t const bytes_per_pulse)
+	: m_limit(limit), m_window(window), m_bytes_per_pulse(bytes_per_pulse)
+{
+	if (m_window == 0)
+		throw std::invalid_argument("PlaybackAnalyzer: window has to be non-zero");
+}
+
+PlaybackLoad PlaybackAnalyzer::analyze(PulseEventContainer const& events) const
+{
+	PlaybackLoad load;
+	load.pulses = events.size();
+	load.window = m_window;
+	load.peak_pulses = 0;
+	load.peak_time = 0;
+	load.pulses_per_link.assign(PlaybackLoad::num_links, 0);
+	load.memory_bytes = events.size() * m_bytes_per_pulse;
+	load.delayed_pulses = 0;
+	load.max_release_delay = 0;
+	load.dropped_pulses = 0;
+
+	// sliding window over the nominal release times (half the DNC time)
+	auto const& data = events.data();
+	size_t first = 0;
+	for (size_t last = 0; last < data.size(); ++last) {
+		++load.pulses_per_link[PlaybackLoad::link(data[last].getLabel())];
+		while (data[last].getTime() / 2 - data[first].getTime() / 2 >= m_window) {
+			++first;
+		}
+		if (last - first + 1 > load.peak_pulses) {
+			load.peak_pulses = last - first + 1;
+			load.peak_time = data[first].getTime();
+		}
+	}
+
+	simulate_release(events, m_limit, [this, &load](PulseEvent const&, std::int64_t const delay) {
+		if (delay > std::int64_t(m_limit.max_delay)) {
+			++load.dropped_pulses;
+			return false;
+		}
+		if (delay > 0) {
+			++load.delayed_pulses;
+			load.max_release_delay = std::max(load.max_release_delay, size_t(delay));
+		}
+		return true;
+	});
+	return load;
+}
+
+PulseEventContainer PlaybackAnalyzer::dropped(PulseEventContainer const& events) const
+{
+	PulseEventContainer::container_type result;
+	simulate_release(
+		events, m_limit, [this, &result](PulseEvent const& event, std::int64_t const delay) {
+			if (delay > std::int64_t(m_limit.max_delay)) {
+				result.push_back(event);
+				return false;
+			}
+			return true;
+		});
+	return PulseEventContainer(std::move(result), true);
+}
+
+PlaybackAnalyzer::ShapingResult PlaybackAnalyzer::shape(
+	PulseEventContainer const& events, PulseEvent::spiketime_t const delay_budget) const
+{
+	ShapingResult result;
+	result.moved = 0;
+	result.max_shift = 0;
+
+	PulseEventContainer::container_type shaped;
+	PulseEventContainer::container_type dropped;
+	shaped.reserve(events.size());
+
+	// Pulses exceeding the maximum release delay are moved later by the excess,
+	// i.e. they are released exactly max_delay cycles late. The resulting
+	// schedule is feasible and release order follows time order, hence the
+	// FPGA does not drop any of the shaped pulses.
+	simulate_release(events, m_limit, [&](PulseEvent const& event, std::int64_t const delay) {
+		std::int64_t const excess = delay - std::int64_t(m_limit.max_delay);
+		if (excess <= 0) {
+			shaped.push_back(event);
+			return true;
+		}
+		PulseEvent::spiketime_t const shift = 2 * excess;
+		if (shift > delay_budget) {
+			dropped.push_back(event);
+			return false;
+		}
+		PulseEvent moved(event);
+		moved.setTime(event.getTime() + shift);
+		shaped.push_back(moved);
+		++result.moved;
+		result.max_shift = std::max(result.max_shift, shift);
+		return true;
+	});
+
+	result.events = PulseEventContainer(std::move(shaped), true);
+	result.dropped = PulseEventContainer(std::move(dropped), true);
+	return result;
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hal/FPGAContainer.h"
+#include "hal/FPGA/ReleaseLimit.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Load a pulse sequence puts on the FPGA playback.
+ */
+struct PlaybackLoad
+{
+	/// Number of links, i.e. combinations of DNC, HICANN on DNC and Gbit link.
+	static const size_t num_links = PulseAddress::num_labels >> 6;
+
+	/// Link of @a label, i.e. the label without the L1 address.
+	static size_t link(PulseAddress::label_t const label)
+	{
+		return (label >> 6) & (num_links - 1);
+	}
+
+	size_t pulses;
+
+	/// Window (in FPGA cycles) of the peak load.
+	std::uint64_t window;
+	/// Maximum number of pulses to be released within any window.
+	size_t peak_pulses;
+	/// Time (in DNC cycles) of the first pulse of that window.
+	PulseEvent::spiketime_t peak_time;
+
+	/// Pulses per link, indexed by link() of the label.
+	std::vector<size_t> pulses_per_link;
+
+	/// Size of the pulses in the playback memory.
+	size_t memory_bytes;
+
+	/// Pulses released after their nominal release time.
+	size_t delayed_pulses;
+	/// Maximum release delay (in FPGA cycles) of the pulses not dropped.
+	size_t max_release_delay;
+	/// Pulses dropped as they would be delayed by more than ReleaseLimit::max_delay.
+	size_t dropped_pulses;
+
+	/// Peak load relative to the release capacity of one pulse per cycle.
+	double peak_utilization() const { return window ? double(peak_pulses) / window : 0.; }
+};
+
+/**
+ * @brief Analysis and shaping of pulse sequences before uploading them to the
+ *        playback memory.
+ *
+ * The release of pulses is modeled by ReleaseLimit. shape() removes the
+ * overload by moving pulses which would be dropped to later times, within a
+ * given budget.
+ */
+class PlaybackAnalyzer
+{
+public:
+	/// 1 us in FPGA cycles.
+	static const std::uint64_t default_window = 125;
+	/// Assumed size of a pulse in the playback memory.
+	static const size_t default_bytes_per_pulse = 8;
+
+	/**
+	 * @throw std::invalid_argument If @a window is zero.
+	 */
+	explicit PlaybackAnalyzer(
+		ReleaseLimit const& limit = ReleaseLimit(),
+		std::uint64_t window = default_window,
+		size_t bytes_per_pulse = default_bytes_per_pulse);
+
+	PlaybackLoad analyze(PulseEventContainer const& events) const;
+
+	/// Pulses which would be dropped on release.
+	PulseEventContainer dropped(PulseEventContainer const& events) const;
+
+	struct ShapingResult
+	{
+		/// Pulses, some of them moved to later times, all released in time.
+		PulseEventContainer events;
+		/// Pulses which could not be moved within the budget.
+		PulseEventContainer dropped;
+		/// Number of moved pulses.
+		size_t moved;
+		/// Maximum shift of a moved pulse in DNC cycles.
+		PulseEvent::spiketime_t max_shift;
+	};
+
+	/**
+	 * @brief Moves pulses which would be dropped by at most @a delay_budget DNC
+	 *        cycles, such that they are released in time.
+	 */
+	ShapingResult shape(
+		PulseEventContainer const& events, PulseEvent::spiketime_t delay_budget) const;
+
+private:
+	ReleaseLimit m_limit;
+	std::uint64_t m_window;
+	size_t m_bytes_per_pulse;
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,70 @@
+#include "hal/FPGA/PlaybackProgram.h"
+
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+namespace HMF {
+namespace FPGA {
+
+PlaybackProgram::PlaybackProgram()
+	: m_pulses(), m_runtime(0), m_fpga_hicann_delay(0), m_end_of_experiment_timestamp(0)
+{
+}
+
+PlaybackProgram::PlaybackProgram(
+	PulseEventContainer const& events,
+	PulseEvent::spiketime_t const runtime,
+	std::uint16_t const fpga_hicann_delay)
+	: m_pulses(),
+	  m_runtime(runtime),
+	  m_fpga_hicann_delay(fpga_hicann_delay),
+	  m_end_of_experiment_timestamp(0)
+{
+	PlaybackPulseEncoder encoder;
+	encoder.encode(events, runtime, fpga_hicann_delay);
+	m_pulses = encoder.pulses();
+	m_end_of_experiment_timestamp = encoder.end_of_experiment_timestamp();
+}
+
+PulseEventContainer PlaybackProgram::events() const
+{
+	PulseEventContainer::container_type events;
+	events.reserve(m_pulses.size());
+	for (auto const& pulse : m_pulses) {
+		events.push_back(PulseEvent(PulseAddress(pulse.label), pulse.hicann_time));
+	}
+	return PulseEventContainer(std::move(events), true);
+}
+
+void PlaybackProgram::save(std::string const& filename) const
+{
+	std::ofstream stream(filename, std::ios::binary);
+	if (!stream)
+		throw std::runtime_error("PlaybackProgram: can not open " + filename + " for writing");
+	boost::archive::binary_oarchive archive(stream);
+	archive << *this;
+}
+
+PlaybackProgram PlaybackProgram::load(std::string const& filename)
+{
+	std::ifstream stream(filename, std::ios::binary);
+	if (!stream)
+		throw std::runtime_error("PlaybackProgram: can not open " + filename + " for reading");
+	PlaybackProgram program;
+	boost::archive::binary_iarchive archive(stream);
+	archive >> program;
+	return program;
+}
+
+bool PlaybackProgram::operator==(PlaybackProgram const& other) const
+{
+	return m_pulses == other.m_pulses && m_runtime == other.m_runtime &&
+	       m_fpga_hicann_delay == other.m_fpga_hicann_delay &&
+	       m_end_of_experiment_timestamp == other.m_end_of_experiment_timestamp;
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <boost/serialization/vector.hpp>
+
+#include "hal/FPGAContainer.h"
+#include "hal/FPGA/PlaybackPulses.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Playback memory content compiled from a pulse list.
+ *
+ * Validation and encoding of the pulses (cf. write_playback_pulses()) happen
+ * once on construction, the program can then be uploaded repeatedly by
+ * write_playback_program() without any further processing. It includes the
+ * end-of-experiment marker derived from the runtime.
+ *
+ * Programs can be saved to a file, e.g. to compile stimuli offline. The file
+ * format is a boost binary archive, i.e. it is only portable between hosts of
+ * the same endianness and word size.
+ */
+class PlaybackProgram
+{
+public:
+	typedef PlaybackPulseEncoder::buffer_type buffer_type;
+
+	PlaybackProgram();
+
+	/**
+	 * @param events            Pulse list
+	 * @param runtime           Experiment runtime in DNC cycles
+	 * @param fpga_hicann_delay Number of FPGA clock cycles by which pulses are
+	 *                          released before their time, cf. write_playback_pulses().
+	 * @throw std::runtime_error If the pulse list is invalid, cf. PlaybackPulseEncoder.
+	 */
+	PlaybackProgram(
+		PulseEventContainer const& events,
+		PulseEvent::spiketime_t runtime,
+		std::uint16_t fpga_hicann_delay = 40);
+
+	buffer_type const& pulses() const { return m_pulses; }
+	size_t size() const { return m_pulses.size(); }
+
+	PulseEvent::spiketime_t runtime() const { return m_runtime; }
+	std::uint16_t fpga_hicann_delay() const { return m_fpga_hicann_delay; }
+
+	/// Time of the end-of-experiment marker in FPGA clock cycles.
+	std::uint64_t end_of_experiment_timestamp() const { return m_end_of_experiment_timestamp; }
+
+	/// Pulse list the program was compiled from.
+	PulseEventContainer events() const;
+
+	void save(std::string const& filename) const;
+
+	/**
+	 * @throw std::runtime_error If the file can not be read.
+	 */
+	static PlaybackProgram load(std::string const& filename);
+
+	bool operator==(PlaybackProgram const& other) const;
+	bool operator!=(PlaybackProgram const& other) const { return !(*this == other); }
+
+private:
+	buffer_type m_pulses;
+	PulseEvent::spiketime_t m_runtime;
+	std::uint16_t m_fpga_hicann_delay;
+	std::uint64_t m_end_of_experiment_timestamp;
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, unsigned int const)
+	{
+		using boost::serialization::make_nvp;
+		// clang-format off
+		ar & make_nvp("pulses", m_pulses)
+		   & make_nvp("runtime", m_runtime)
+		   & make_nvp("fpga_hicann_delay", m_fpga_hicann_delay)
+		   & make_nvp("end_of_experiment_timestamp", m_end_of_experiment_timestamp);
+		// clang-format on
+	}
+};
+
+} // namespace FPGA
+} // namespace HMF
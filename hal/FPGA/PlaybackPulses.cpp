@@ -0,0 +1,54 @@
+#include "hal/FPGA/PlaybackPulses.h"
+
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+PlaybackPulseEncoder::PlaybackPulseEncoder() : m_pulses(), m_end_of_experiment_timestamp(0) {}
+
+std::uint64_t PlaybackPulseEncoder::validate(
+	PulseEventContainer const& events,
+	PulseEvent::spiketime_t const runtime,
+	std::uint16_t const fpga_hicann_delay)
+{
+	auto const& data = events.data();
+
+	// The container is sorted by time, so checking the earliest and latest pulse suffices.
+	if (!data.empty() && data.front().getTime() < fpga_hicann_delay * 2)
+		throw std::runtime_error(
+			"write_playback_pulses: the time of the PulseEvent in the spike "
+			"list has to be greater or equal than fpga_hicann_delay*2");
+
+	// Calculate EoE timestamp in FPGA clock cycles, devide by two as DNC frequency == 2 * FPGA frequency
+	std::uint64_t const end_of_experiment_timestamp = (runtime + 1) / 2;
+	std::uint64_t const last_fpga_time =
+		data.empty() ? 0 : release_time(data.back().getTime(), fpga_hicann_delay);
+	if (end_of_experiment_timestamp < last_fpga_time)
+		throw std::runtime_error("write_playback_pulses: runtime shorter than spike trains length");
+	return end_of_experiment_timestamp;
+}
+
+void PlaybackPulseEncoder::encode(
+	PulseEventContainer const& events,
+	PulseEvent::spiketime_t const runtime,
+	std::uint16_t const fpga_hicann_delay)
+{
+	std::uint64_t const end_of_experiment_timestamp = validate(events, runtime, fpga_hicann_delay);
+
+	auto const& data = events.data();
+	size_t const npulses = data.size();
+	m_pulses.resize(npulses);
+	PulseEvent const* const in = data.data();
+	PlaybackPulse* const out = m_pulses.data();
+	for (size_t n = 0; n < npulses; ++n) {
+		PulseEvent::spiketime_t const time = in[n].getTime();
+		out[n].fpga_time = release_time(time, fpga_hicann_delay);
+		out[n].hicann_time = time;
+		out[n].label = in[n].getLabel();
+	}
+	m_end_of_experiment_timestamp = end_of_experiment_timestamp;
+}
+
+} // namespace FPGA
+} // namespace HMF
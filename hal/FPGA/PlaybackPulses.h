@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <boost/serialization/vector.hpp>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Pulse entry of the FPGA playback memory.
+ */
+struct PlaybackPulse
+{
+	/// Release time in FPGA clock cycles (half the DNC frequency).
+	std::uint64_t fpga_time;
+	/// Time of the pulse in DNC clock cycles.
+	PulseEvent::spiketime_t hicann_time;
+	PulseAddress::label_t label;
+
+	bool operator==(PlaybackPulse const& other) const
+	{
+		return fpga_time == other.fpga_time && hicann_time == other.hicann_time &&
+		       label == other.label;
+	}
+
+	bool operator!=(PlaybackPulse const& other) const { return !(*this == other); }
+
+private:
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, unsigned int const)
+	{
+		using boost::serialization::make_nvp;
+		ar & make_nvp("fpga_time", fpga_time)
+		   & make_nvp("hicann_time", hicann_time)
+		   & make_nvp("label", label);
+	}
+};
+
+/**
+ * @brief Batch encoder of playback pulses.
+ *
+ * Converts a whole PulseEventContainer into playback entries at once. As the
+ * container is sorted, the validation of all pulse times reduces to checking
+ * the first and the last pulse; the conversion itself is a branch-free pass
+ * over the events into a contiguous buffer, which is reused by subsequent
+ * calls to encode().
+ */
+class PlaybackPulseEncoder
+{
+public:
+	typedef std::vector<PlaybackPulse> buffer_type;
+
+	PlaybackPulseEncoder();
+
+	/**
+	 * Checks the times of @a events, cf. encode().
+	 * @return Time of the end-of-experiment marker in FPGA clock cycles.
+	 */
+	static std::uint64_t validate(
+		PulseEventContainer const& events,
+		PulseEvent::spiketime_t runtime,
+		std::uint16_t fpga_hicann_delay);
+
+	/// Release time in FPGA clock cycles of a pulse at @a time in DNC cycles.
+	static std::uint64_t release_time(
+		PulseEvent::spiketime_t const time, std::uint16_t const fpga_hicann_delay)
+	{
+		// DNC frequency == 2 * FPGA frequency
+		return (time >> 1) - fpga_hicann_delay;
+	}
+
+	/**
+	 * @param events            Pulse list
+	 * @param runtime           Experiment runtime in DNC cycles
+	 * @param fpga_hicann_delay Number of FPGA clock cycles by which pulses are
+	 *                          released before their time, cf. write_playback_pulses().
+	 * @throw std::runtime_error If a pulse is earlier than 2 * fpga_hicann_delay
+	 *        or the runtime is shorter than the pulse list.
+	 */
+	void encode(
+		PulseEventContainer const& events,
+		PulseEvent::spiketime_t runtime,
+		std::uint16_t fpga_hicann_delay);
+
+	buffer_type const& pulses() const { return m_pulses; }
+
+	/// Time of the end-of-experiment marker in FPGA clock cycles.
+	std::uint64_t end_of_experiment_timestamp() const { return m_end_of_experiment_timestamp; }
+
+private:
+	buffer_type m_pulses;
+	std::uint64_t m_end_of_experiment_timestamp;
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -10,6 +10,7 @@ namespace FPGA {
 using namespace ::HMF::Coordinate;
 
 const PulseAddress::label_t PulseAddress::default_label;
+const size_t PulseAddress::num_labels;
 
 PulseAddress::dnc_address_t PulseAddress:: getDncAddress() const
 {
@@ -37,6 +37,8 @@ struct PulseAddress
 public:
 	// All Halbe Coordinates are set to zero
 	static const label_t default_label = 0x1c0;
+	// Number of distinct (14 bit) labels
+	static const size_t num_labels = 1 << 14;
 
 	// TODO: SJ: Does a public default constructor make any sense in this
 	// context?
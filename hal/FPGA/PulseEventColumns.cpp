@@ -0,0 +1,197 @@
+#include "hal/FPGA/PulseEventColumns.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+size_t const PulseEventColumns::checkpoint_interval;
+
+PulseEventColumns::const_iterator::const_iterator(
+	PulseEventColumns const& columns, size_t const index)
+	: m_columns(&columns), m_index(index), m_checkpoint(0), m_time(0)
+{
+	if (m_index >= m_columns->size()) {
+		return;
+	}
+	m_time = m_columns->time(m_index);
+	if (m_columns->m_encoding == TimeEncoding::delta) {
+		auto const& indices = m_columns->m_checkpoint_indices;
+		m_checkpoint = std::upper_bound(indices.begin(), indices.end(), m_index) - indices.begin();
+	}
+}
+
+PulseEventColumns::const_iterator& PulseEventColumns::const_iterator::operator++()
+{
+	++m_index;
+	if (m_index >= m_columns->size()) {
+		return *this;
+	}
+	if (m_columns->m_encoding == TimeEncoding::absolute) {
+		m_time = m_columns->m_times[m_index];
+	} else if (
+		m_checkpoint < m_columns->m_checkpoint_indices.size() &&
+		m_columns->m_checkpoint_indices[m_checkpoint] == m_index) {
+		m_time = m_columns->m_checkpoint_times[m_checkpoint];
+		++m_checkpoint;
+	} else {
+		m_time += m_columns->m_time_deltas[m_index];
+	}
+	return *this;
+}
+
+PulseEventColumns::PulseEventColumns(TimeEncoding const encoding)
+	: m_encoding(encoding),
+	  m_labels(),
+	  m_times(),
+	  m_time_deltas(),
+	  m_checkpoint_indices(),
+	  m_checkpoint_times(),
+	  m_last_time(0)
+{
+}
+
+PulseEventColumns::PulseEventColumns(
+	AlmostSortedPulseEvents const& events, TimeEncoding const encoding)
+	: PulseEventColumns(encoding)
+{
+	assign(events.events);
+}
+
+PulseEventColumns::PulseEventColumns(
+	PulseEventContainer const& events, TimeEncoding const encoding)
+	: PulseEventColumns(encoding)
+{
+	assign(events.data());
+}
+
+PulseEventColumns::PulseEventColumns(
+	PulseEventContainer::container_type const& events, TimeEncoding const encoding)
+	: PulseEventColumns(encoding)
+{
+	assign(events);
+}
+
+template <typename Events>
+void PulseEventColumns::assign(Events const& events)
+{
+	clear();
+	reserve(events.size());
+	for (auto const& event : events) {
+		push_back(event);
+	}
+}
+
+void PulseEventColumns::reserve(size_t const size)
+{
+	m_labels.reserve(size);
+	if (m_encoding == TimeEncoding::absolute) {
+		m_times.reserve(size);
+	} else {
+		m_time_deltas.reserve(size);
+	}
+}
+
+void PulseEventColumns::clear()
+{
+	m_labels.clear();
+	m_times.clear();
+	m_time_deltas.clear();
+	m_checkpoint_indices.clear();
+	m_checkpoint_times.clear();
+	m_last_time = 0;
+}
+
+void PulseEventColumns::push_back(PulseEvent const& event)
+{
+	spiketime_t const time = event.getTime();
+
+	if (m_encoding == TimeEncoding::absolute) {
+		m_times.push_back(time);
+	} else {
+		static spiketime_t const max_delta = std::numeric_limits<time_delta_t>::max();
+		bool const fits = (time >= m_last_time) ? (time - m_last_time <= max_delta)
+		                                        : (m_last_time - time <= max_delta);
+		if (m_labels.size() % checkpoint_interval == 0 || !fits) {
+			m_checkpoint_indices.push_back(m_labels.size());
+			m_checkpoint_times.push_back(time);
+			m_time_deltas.push_back(0);
+		} else {
+			m_time_deltas.push_back(static_cast<time_delta_t>(
+				static_cast<std::int64_t>(time - m_last_time)));
+		}
+		m_last_time = time;
+	}
+
+	m_labels.push_back(event.getLabel());
+}
+
+PulseEventColumns::spiketime_t PulseEventColumns::time(size_t const ii) const
+{
+	if (m_encoding == TimeEncoding::absolute) {
+		return m_times[ii];
+	}
+
+	auto const checkpoint =
+		std::upper_bound(m_checkpoint_indices.begin(), m_checkpoint_indices.end(), ii) - 1;
+	spiketime_t time = m_checkpoint_times[checkpoint - m_checkpoint_indices.begin()];
+	for (size_t jj = *checkpoint + 1; jj <= ii; ++jj) {
+		time += m_time_deltas[jj];
+	}
+	return time;
+}
+
+PulseEvent PulseEventColumns::operator[](size_t const ii) const
+{
+	return PulseEvent(PulseAddress(m_labels[ii]), time(ii));
+}
+
+std::vector<PulseEventColumns::spiketime_t> const& PulseEventColumns::times() const
+{
+	if (m_encoding != TimeEncoding::absolute) {
+		throw std::logic_error("time column of PulseEventColumns is delta-encoded");
+	}
+	return m_times;
+}
+
+std::vector<PulseEventColumns::spiketime_t> PulseEventColumns::times_of(label_t const label) const
+{
+	std::vector<spiketime_t> result;
+	if (m_encoding == TimeEncoding::absolute) {
+		for (size_t ii = 0; ii < m_labels.size(); ++ii) {
+			if (m_labels[ii] == label) {
+				result.push_back(m_times[ii]);
+			}
+		}
+	} else {
+		for (auto it = begin(); it != end(); ++it) {
+			if (m_labels[it.m_index] == label) {
+				result.push_back(it.m_time);
+			}
+		}
+	}
+	return result;
+}
+
+PulseEventContainer::container_type PulseEventColumns::events() const
+{
+	PulseEventContainer::container_type result;
+	result.reserve(size());
+	for (auto it = begin(); it != end(); ++it) {
+		result.push_back(*it);
+	}
+	return result;
+}
+
+bool PulseEventColumns::operator==(PulseEventColumns const& other) const
+{
+	return m_encoding == other.m_encoding && m_labels == other.m_labels &&
+	       m_times == other.m_times && m_time_deltas == other.m_time_deltas &&
+	       m_checkpoint_indices == other.m_checkpoint_indices &&
+	       m_checkpoint_times == other.m_checkpoint_times;
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <boost/serialization/vector.hpp>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Pulse events stored column-wise, i.e. as separate label and time arrays.
+ *
+ * Compared to a vector of PulseEvent (16 bytes per event due to padding) this
+ * needs 10 bytes per event, or about 6 bytes if times are delta-encoded. Scans
+ * over a single column (e.g. all spike times of one label) only touch the
+ * memory of that column.
+ *
+ * Delta-encoded times are stored as signed 32 bit differences to the preceding
+ * event, hence almost-sorted input (e.g. AlmostSortedPulseEvents) is supported
+ * as well. Every checkpoint_interval events, and whenever a difference does not
+ * fit, the absolute time is stored as a checkpoint to bound the cost of
+ * random access.
+ *
+ * The iterators yield PulseEvent values, so that algorithms written for the
+ * existing containers can be used unmodified. As the events are materialized
+ * on access, they are input iterators only.
+ */
+class PulseEventColumns
+{
+public:
+	typedef PulseAddress::label_t label_t;
+	typedef PulseEvent::spiketime_t spiketime_t;
+	typedef std::int32_t time_delta_t;
+
+	enum class TimeEncoding
+	{
+		absolute,
+		delta
+	};
+
+	static size_t const checkpoint_interval = 1024;
+
+	class const_iterator
+	{
+	public:
+		/// Holds a materialized event for operator->().
+		class pointer
+		{
+		public:
+			PulseEvent const* operator->() const { return &m_event; }
+
+		private:
+			friend class const_iterator;
+			explicit pointer(PulseEvent const& event) : m_event(event) {}
+
+			PulseEvent m_event;
+		};
+
+		typedef std::input_iterator_tag iterator_category;
+		typedef PulseEvent value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef PulseEvent reference;
+
+		const_iterator() : m_columns(nullptr), m_index(0), m_checkpoint(0), m_time(0) {}
+
+		PulseEvent operator*() const
+		{
+			return PulseEvent(PulseAddress(m_columns->m_labels[m_index]), m_time);
+		}
+
+		pointer operator->() const { return pointer(**this); }
+
+		const_iterator& operator++();
+		const_iterator operator++(int)
+		{
+			const_iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		bool operator==(const_iterator const& other) const { return m_index == other.m_index; }
+		bool operator!=(const_iterator const& other) const { return m_index != other.m_index; }
+
+	private:
+		friend class PulseEventColumns;
+		const_iterator(PulseEventColumns const& columns, size_t index);
+
+		PulseEventColumns const* m_columns;
+		size_t m_index;
+		// next checkpoint of delta-encoded times
+		size_t m_checkpoint;
+		spiketime_t m_time;
+	};
+
+	explicit PulseEventColumns(TimeEncoding encoding = TimeEncoding::absolute);
+
+	explicit PulseEventColumns(
+		AlmostSortedPulseEvents const& events, TimeEncoding encoding = TimeEncoding::absolute);
+	explicit PulseEventColumns(
+		PulseEventContainer const& events, TimeEncoding encoding = TimeEncoding::absolute);
+	explicit PulseEventColumns(
+		PulseEventContainer::container_type const& events,
+		TimeEncoding encoding = TimeEncoding::absolute);
+
+	TimeEncoding time_encoding() const { return m_encoding; }
+
+	void reserve(size_t size);
+	void clear();
+	void push_back(PulseEvent const& event);
+
+	size_t size() const { return m_labels.size(); }
+	bool empty() const { return m_labels.empty(); }
+
+	/// Time of the event at index @a ii (constant time for absolute encoding).
+	spiketime_t time(size_t ii) const;
+	label_t label(size_t ii) const { return m_labels[ii]; }
+	PulseEvent operator[](size_t ii) const;
+
+	const_iterator begin() const { return const_iterator(*this, 0); }
+	const_iterator end() const { return const_iterator(*this, size()); }
+
+	/// Label column.
+	std::vector<label_t> const& labels() const { return m_labels; }
+
+	/**
+	 * @brief Time column.
+	 * @throw std::logic_error If times are delta-encoded.
+	 */
+	std::vector<spiketime_t> const& times() const;
+
+	/// Times of all events with label @a label, in order of storage.
+	std::vector<spiketime_t> times_of(label_t label) const;
+
+	/// Conversion to the row-wise representation.
+	PulseEventContainer::container_type events() const;
+
+	bool operator==(PulseEventColumns const& other) const;
+	bool operator!=(PulseEventColumns const& other) const { return !(*this == other); }
+
+private:
+	template <typename Events>
+	void assign(Events const& events);
+
+	TimeEncoding m_encoding;
+	std::vector<label_t> m_labels;
+
+	// absolute encoding
+	std::vector<spiketime_t> m_times;
+
+	// delta encoding
+	std::vector<time_delta_t> m_time_deltas;
+	std::vector<size_t> m_checkpoint_indices;
+	std::vector<spiketime_t> m_checkpoint_times;
+	spiketime_t m_last_time;
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, unsigned int const)
+	{
+		using namespace boost::serialization;
+		// clang-format off
+		ar & make_nvp("encoding", m_encoding)
+		   & make_nvp("labels", m_labels)
+		   & make_nvp("times", m_times)
+		   & make_nvp("time_deltas", m_time_deltas)
+		   & make_nvp("checkpoint_indices", m_checkpoint_indices)
+		   & make_nvp("checkpoint_times", m_checkpoint_times)
+		   & make_nvp("last_time", m_last_time);
+		// clang-format on
+	}
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,62 @@
+#include "hal/FPGA/PulseEventPartition.h"
+
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+PulseEventPartition::PulseEventPartition(PulseEventContainer const& events, Prefix const prefix)
+	: PulseEventPartition(events.data(), prefix)
+{}
+
+PulseEventPartition::PulseEventPartition(container_type const& events, Prefix const prefix)
+	: m_prefix(prefix), m_events(events.size()), m_offsets()
+{
+	size_t const bucket_shift = shift(m_prefix);
+	size_t const buckets = PulseAddress::num_labels >> bucket_shift;
+	auto const bucket = [bucket_shift, buckets](PulseEvent const& event) {
+		return (event.getLabel() >> bucket_shift) & (buckets - 1);
+	};
+
+	m_offsets.assign(buckets + 1, 0);
+	for (auto const& event : events) {
+		++m_offsets[bucket(event) + 1];
+	}
+	for (size_t bb = 0; bb < buckets; ++bb) {
+		m_offsets[bb + 1] += m_offsets[bb];
+	}
+
+	std::vector<size_t> next(m_offsets.begin(), m_offsets.end() - 1);
+	for (auto const& event : events) {
+		m_events[next[bucket(event)]++] = event;
+	}
+}
+
+size_t PulseEventPartition::shift(Prefix const prefix)
+{
+	switch (prefix) {
+		case Prefix::dnc:
+			return 12;
+		case Prefix::chip:
+			return 9;
+		case Prefix::channel:
+			return 6;
+	}
+	throw std::invalid_argument("PulseEventPartition: invalid prefix");
+}
+
+PulseAddress PulseEventPartition::address(size_t const bucket) const
+{
+	if (bucket >= num_buckets())
+		throw std::out_of_range("PulseEventPartition: invalid bucket");
+	return PulseAddress(static_cast<PulseAddress::label_t>(bucket << shift(m_prefix)));
+}
+
+PulseEventPartition::span_type PulseEventPartition::operator[](size_t const bucket) const
+{
+	PulseEvent const* const events = m_events.data();
+	return span_type(events + m_offsets[bucket], events + m_offsets[bucket + 1]);
+}
+
+} // namespace FPGA
+} // namespace HMF
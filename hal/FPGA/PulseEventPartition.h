@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Pulse events grouped by a prefix of their label.
+ *
+ * The label consists of DNC (2 bit), chip (3 bit), channel (3 bit) and L1
+ * address (6 bit). Partitioning by one of the prefixes yields a bucket per DNC
+ * (4), per HICANN (4 * 8) or per Gbit link (4 * 8 * 8). The events are
+ * distributed by a stable counting sort, i.e. in a single scatter pass after
+ * counting, hence each bucket keeps the order of the input, e.g. sorted by time
+ * for a PulseEventContainer. Buckets are handed out as spans into a single
+ * contiguous copy of the events.
+ *
+ * Bucket @c b holds all events with <tt>label >> shift(prefix) == b</tt> (bits
+ * beyond the 14 bit label are ignored), the coordinates of a bucket can be
+ * obtained from address(b).
+ */
+class PulseEventPartition
+{
+public:
+	typedef PulseEventContainer::container_type container_type;
+	typedef std::pair<PulseEvent const*, PulseEvent const*> span_type;
+
+	enum class Prefix
+	{
+		dnc,
+		chip,
+		channel
+	};
+
+	PulseEventPartition(PulseEventContainer const& events, Prefix prefix);
+	PulseEventPartition(container_type const& events, Prefix prefix);
+
+	Prefix prefix() const { return m_prefix; }
+
+	/// Number of label bits below the prefix.
+	static size_t shift(Prefix prefix);
+
+	size_t num_buckets() const { return m_offsets.size() - 1; }
+
+	/// Bucket of the events matching the prefix of @a address.
+	size_t bucket_of(PulseAddress const& address) const
+	{
+		return (address.getLabel() >> shift(m_prefix)) & (num_buckets() - 1);
+	}
+
+	/// Address (with all bits below the prefix cleared) of the events in @a bucket.
+	PulseAddress address(size_t bucket) const;
+
+	/// Events of @a bucket, valid as long as the partition.
+	span_type operator[](size_t bucket) const;
+	size_t size(size_t bucket) const { return m_offsets[bucket + 1] - m_offsets[bucket]; }
+
+	/// All events grouped by bucket.
+	container_type const& data() const { return m_events; }
+
+private:
+	Prefix m_prefix;
+	container_type m_events;
+	// events of bucket b are m_events[m_offsets[b], m_offsets[b + 1])
+	std::vector<size_t> m_offsets;
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,44 @@
+#include "hal/FPGA/ReleaseLimit.h"
+
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+size_t const ReleaseLimit::default_max_delay;
+
+ReleaseLimit::ReleaseLimit(std::uint16_t const fpga_hicann_delay_, size_t const max_delay_)
+	: fpga_hicann_delay(fpga_hicann_delay_), max_delay(max_delay_)
+{}
+
+PulseEventContainer ReleaseLimit::apply(
+	PulseEventContainer const& events, size_t& dropped_events) const
+{
+	PulseEventContainer::container_type released;
+	released.reserve(events.size());
+	dropped_events = 0;
+
+	// release time of the previous pulse in FPGA cycles
+	std::int64_t previous = 0;
+	for (auto const& event : events.data()) {
+		if (event.getTime() < 2 * PulseEvent::spiketime_t(fpga_hicann_delay))
+			throw std::runtime_error(
+				"ReleaseLimit: the time of the PulseEvent has to be greater or equal than "
+				"fpga_hicann_delay*2");
+		std::int64_t const release = event.getTime() / 2 - fpga_hicann_delay;
+
+		if (release - previous >= 1) {
+			previous = release;
+		} else if (release - previous + std::int64_t(max_delay) >= 1) {
+			++previous;
+		} else {
+			++dropped_events;
+			continue;
+		}
+		released.push_back(event);
+	}
+	return PulseEventContainer(std::move(released), true);
+}
+
+} // namespace FPGA
+} // namespace HMF
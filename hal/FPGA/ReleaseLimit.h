@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Model of the FPGA playback release, which sends at most one pulse per
+ *        FPGA clock cycle (8 ns, two DNC clock cycles).
+ *
+ * Pulses are released fpga_hicann_delay FPGA cycles before their time. Pulses
+ * following each other too closely are released late by up to max_delay
+ * cycles, which is harmless as the DNC releases them according to their time
+ * stamp. Pulses that would have to be delayed further are dropped. This is the
+ * logic of the ESS playback (HAL2ESS::write_playback_pulses).
+ */
+struct ReleaseLimit
+{
+	/// 100 ns in FPGA cycles, as used by the ESS.
+	static const size_t default_max_delay = 12;
+
+	explicit ReleaseLimit(
+		std::uint16_t fpga_hicann_delay = 40, size_t max_delay = default_max_delay);
+
+	std::uint16_t fpga_hicann_delay;
+	size_t max_delay;
+
+	/**
+	 * @brief Pulse events which are released in time.
+	 * @param dropped_events Set to the number of dropped pulse events.
+	 * @throw std::runtime_error If a pulse is earlier than 2 * fpga_hicann_delay.
+	 */
+	PulseEventContainer apply(PulseEventContainer const& events, size_t& dropped_events) const;
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,287 @@
+#include "hal/FPGA/SpikeFile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace HMF {
+namespace FPGA {
+
+static_assert(sizeof(SpikeFileHeader) == 64, "unexpected spike file header size");
+static_assert(sizeof(SpikeFileRecord) == 16, "unexpected spike file record size");
+static_assert(sizeof(SpikeFileIndexEntry) == 16, "unexpected spike file index entry size");
+
+std::uint64_t const SpikeFileHeader::magic_value;
+std::uint32_t const SpikeFileHeader::current_version;
+size_t const SpikeFileWriter::default_index_stride;
+
+namespace {
+
+// number of records buffered before writing them to the file
+size_t const buffer_size = 1 << 16;
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// SpikeFileWriter
+
+SpikeFileWriter::SpikeFileWriter(std::string const& filename, size_t const index_stride)
+	: m_stream(),
+	  m_filename(filename),
+	  m_index_stride(index_stride),
+	  m_buffer(),
+	  m_num_events(0),
+	  m_dropped_events(0),
+	  m_sorted(true),
+	  m_last_event(),
+	  m_index()
+{
+	if (m_index_stride == 0)
+		throw std::invalid_argument("SpikeFileWriter: index stride has to be non-zero");
+
+	m_stream.open(filename, std::ios::binary | std::ios::trunc);
+	if (!m_stream)
+		throw std::runtime_error("SpikeFileWriter: can not open " + filename + " for writing");
+
+	// placeholder, the header is written on close
+	SpikeFileHeader const header = {};
+	m_stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	m_buffer.reserve(buffer_size);
+}
+
+SpikeFileWriter::~SpikeFileWriter()
+{
+	try {
+		close();
+	} catch (...) {
+		// destructors must not throw, call close() to handle errors
+	}
+}
+
+void SpikeFileWriter::append(PulseEvent const& event)
+{
+	if (m_num_events > 0 && event < m_last_event)
+		m_sorted = false;
+	m_last_event = event;
+
+	PulseEvent::spiketime_t const time = event.getTime();
+	if (m_num_events % m_index_stride == 0) {
+		m_index.push_back(SpikeFileIndexEntry{time, time});
+	} else {
+		auto& block = m_index.back();
+		block.max_time_until = std::max(block.max_time_until, time);
+		block.min_time_from = std::min(block.min_time_from, time);
+	}
+
+	SpikeFileRecord record = {};
+	record.time = time;
+	record.label = event.getLabel();
+	m_buffer.push_back(record);
+	++m_num_events;
+
+	if (m_buffer.size() >= buffer_size)
+		flush();
+}
+
+void SpikeFileWriter::append(AlmostSortedPulseEvents::container_type const& events)
+{
+	for (auto const& event : events)
+		append(event);
+}
+
+void SpikeFileWriter::set_dropped_events(size_t const dropped_events)
+{
+	m_dropped_events = dropped_events;
+}
+
+void SpikeFileWriter::flush()
+{
+	m_stream.write(
+		reinterpret_cast<char const*>(m_buffer.data()), m_buffer.size() * sizeof(SpikeFileRecord));
+	m_buffer.clear();
+	if (!m_stream)
+		throw std::runtime_error("SpikeFileWriter: failed to write " + m_filename);
+}
+
+void SpikeFileWriter::close()
+{
+	if (!m_stream.is_open())
+		return;
+
+	flush();
+
+	// per block extrema to monotonic prefix maximum and suffix minimum
+	for (size_t ii = 1; ii < m_index.size(); ++ii) {
+		m_index[ii].max_time_until =
+			std::max(m_index[ii].max_time_until, m_index[ii - 1].max_time_until);
+	}
+	for (size_t ii = m_index.size(); ii-- > 1;) {
+		m_index[ii - 1].min_time_from =
+			std::min(m_index[ii - 1].min_time_from, m_index[ii].min_time_from);
+	}
+	m_stream.write(
+		reinterpret_cast<char const*>(m_index.data()), m_index.size() * sizeof(SpikeFileIndexEntry));
+
+	SpikeFileHeader header = {};
+	header.magic = SpikeFileHeader::magic_value;
+	header.version = SpikeFileHeader::current_version;
+	header.flags = m_sorted ? std::uint32_t(SpikeFileHeader::sorted) : 0u;
+	header.num_events = m_num_events;
+	header.dropped_events = m_dropped_events;
+	header.events_offset = sizeof(SpikeFileHeader);
+	header.index_offset = sizeof(SpikeFileHeader) + m_num_events * sizeof(SpikeFileRecord);
+	header.index_stride = m_index_stride;
+	header.index_size = m_index.size();
+	m_stream.seekp(0);
+	m_stream.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+	m_stream.close();
+	if (!m_stream)
+		throw std::runtime_error("SpikeFileWriter: failed to write " + m_filename);
+}
+
+void SpikeFileWriter::write(std::string const& filename, PulseEventContainer const& events)
+{
+	SpikeFileWriter writer(filename);
+	writer.append(events.data());
+	writer.close();
+}
+
+void SpikeFileWriter::write(std::string const& filename, AlmostSortedPulseEvents const& events)
+{
+	SpikeFileWriter writer(filename);
+	writer.append(events.events);
+	writer.set_dropped_events(events.dropped_events);
+	writer.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// SpikeFile
+
+SpikeFile::SpikeFile(std::string const& filename)
+	: m_mapping(MAP_FAILED), m_mapping_size(0), m_header(nullptr), m_records(nullptr), m_index(nullptr)
+{
+	int const fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		throw std::runtime_error(
+			"SpikeFile: can not open " + filename + ": " + std::strerror(errno));
+
+	struct stat status;
+	if (::fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(SpikeFileHeader)) {
+		::close(fd);
+		throw std::runtime_error("SpikeFile: " + filename + " is not a spike file");
+	}
+
+	m_mapping_size = status.st_size;
+	m_mapping = ::mmap(nullptr, m_mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (m_mapping == MAP_FAILED)
+		throw std::runtime_error(
+			"SpikeFile: can not map " + filename + ": " + std::strerror(errno));
+
+	char const* const base = static_cast<char const*>(m_mapping);
+	m_header = reinterpret_cast<SpikeFileHeader const*>(base);
+
+	std::string error;
+	if (m_header->magic != SpikeFileHeader::magic_value) {
+		error = " is not a spike file (or of different byte order)";
+	} else if (m_header->version > SpikeFileHeader::current_version) {
+		error = " has unsupported version " + std::to_string(m_header->version);
+	} else if (
+		m_header->index_stride == 0 ||
+		m_header->events_offset + m_header->num_events * sizeof(SpikeFileRecord) >
+			m_header->index_offset ||
+		m_header->index_offset + m_header->index_size * sizeof(SpikeFileIndexEntry) >
+			m_mapping_size ||
+		m_header->index_size != (m_header->num_events + m_header->index_stride - 1) /
+		                            m_header->index_stride) {
+		error = " is truncated or corrupt";
+	}
+	if (!error.empty()) {
+		::munmap(m_mapping, m_mapping_size);
+		throw std::runtime_error("SpikeFile: " + filename + error);
+	}
+
+	m_records = reinterpret_cast<SpikeFileRecord const*>(base + m_header->events_offset);
+	m_index = reinterpret_cast<SpikeFileIndexEntry const*>(base + m_header->index_offset);
+}
+
+SpikeFile::~SpikeFile()
+{
+	::munmap(m_mapping, m_mapping_size);
+}
+
+std::pair<size_t, size_t> SpikeFile::time_range(
+	PulseEvent::spiketime_t const t_begin, PulseEvent::spiketime_t const t_end) const
+{
+	if (t_begin >= t_end)
+		return std::make_pair(0, 0);
+
+	SpikeFileIndexEntry const* const index_end = m_index + m_header->index_size;
+	size_t const first_block =
+		std::lower_bound(
+			m_index, index_end, t_begin,
+			[](SpikeFileIndexEntry const& entry, PulseEvent::spiketime_t const time) {
+				return entry.max_time_until < time;
+			}) -
+		m_index;
+	size_t const end_block =
+		std::lower_bound(
+			m_index, index_end, t_end,
+			[](SpikeFileIndexEntry const& entry, PulseEvent::spiketime_t const time) {
+				return entry.min_time_from < time;
+			}) -
+		m_index;
+	if (first_block >= end_block)
+		return std::make_pair(0, 0);
+
+	size_t const stride = m_header->index_stride;
+	size_t begin = first_block * stride;
+	size_t end = std::min<size_t>(end_block * stride, size());
+
+	if (is_sorted()) {
+		auto const earlier = [](SpikeFileRecord const& record, PulseEvent::spiketime_t const time) {
+			return record.time < time;
+		};
+		begin = std::lower_bound(m_records + begin, m_records + end, t_begin, earlier) - m_records;
+		end = std::lower_bound(m_records + begin, m_records + end, t_end, earlier) - m_records;
+	}
+	return std::make_pair(begin, end);
+}
+
+AlmostSortedPulseEvents::container_type SpikeFile::events(
+	PulseEvent::spiketime_t const t_begin, PulseEvent::spiketime_t const t_end) const
+{
+	auto const range = time_range(t_begin, t_end);
+	AlmostSortedPulseEvents::container_type result;
+	for (size_t ii = range.first; ii < range.second; ++ii) {
+		auto const time = m_records[ii].time;
+		if (time >= t_begin && time < t_end)
+			result.push_back(m_records[ii].event());
+	}
+	return result;
+}
+
+AlmostSortedPulseEvents SpikeFile::almost_sorted_events() const
+{
+	AlmostSortedPulseEvents::container_type result;
+	result.reserve(size());
+	for (size_t ii = 0; ii < size(); ++ii)
+		result.push_back(m_records[ii].event());
+	return AlmostSortedPulseEvents(std::move(result), dropped_events());
+}
+
+PulseEventContainer SpikeFile::container() const
+{
+	return PulseEventContainer(almost_sorted_events());
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief On-disk representation of pulse events, memory-mappable.
+ *
+ * Layout (native byte order, checked on load):
+ *  - Header (SpikeFileHeader)
+ *  - Events (SpikeFileRecord[num_events]) in order of writing
+ *  - Sparse time index (SpikeFileIndexEntry[index_size]), one entry per block
+ *    of index_stride events
+ *
+ * Each index entry holds the maximum time of all events up to the end of its
+ * block and the minimum time of all events from the begin of its block on.
+ * Both are monotonic, also for almost-sorted traces, hence the events within a
+ * time range can be located by binary search on the index.
+ */
+struct SpikeFileHeader
+{
+	static std::uint64_t const magic_value = 0x4b505345424c4148ull; // "HALBESPK"
+	static std::uint32_t const current_version = 1;
+
+	enum Flags : std::uint32_t
+	{
+		sorted = 1u << 0
+	};
+
+	std::uint64_t magic;
+	std::uint32_t version;
+	std::uint32_t flags;
+	std::uint64_t num_events;
+	std::uint64_t dropped_events;
+	std::uint64_t events_offset;
+	std::uint64_t index_offset;
+	std::uint64_t index_stride;
+	std::uint64_t index_size;
+};
+
+struct SpikeFileRecord
+{
+	PulseEvent::spiketime_t time;
+	PulseAddress::label_t label;
+	std::uint16_t reserved[3];
+
+	PulseEvent event() const { return PulseEvent(PulseAddress(label), time); }
+};
+
+struct SpikeFileIndexEntry
+{
+	/// Maximum time of all events before the end of the block.
+	PulseEvent::spiketime_t max_time_until;
+	/// Minimum time of all events from the begin of the block on.
+	PulseEvent::spiketime_t min_time_from;
+};
+
+/**
+ * @brief Streaming writer of spike files.
+ *
+ * Events are appended in chunks, e.g. directly from the trace readout:
+ * @code
+ * SpikeFileWriter writer("trace.spikes");
+ * writer.set_dropped_events(stream_trace_pulses(
+ *     fpga, runtime, [&writer](AlmostSortedPulseEvents::container_type const& chunk) {
+ *         writer.append(chunk);
+ *     }));
+ * writer.close();
+ * @endcode
+ * The index is written by close(), which is also called by the destructor.
+ */
+class SpikeFileWriter : private boost::noncopyable
+{
+public:
+	static size_t const default_index_stride = 4096;
+
+	/**
+	 * @throw std::runtime_error If the file can not be opened.
+	 * @throw std::invalid_argument If @a index_stride is zero.
+	 */
+	explicit SpikeFileWriter(
+		std::string const& filename, size_t index_stride = default_index_stride);
+	~SpikeFileWriter();
+
+	void append(PulseEvent const& event);
+	void append(AlmostSortedPulseEvents::container_type const& events);
+
+	void set_dropped_events(size_t dropped_events);
+
+	/**
+	 * @brief Writes outstanding events, the index and the header.
+	 * @throw std::runtime_error If writing fails.
+	 */
+	void close();
+
+	size_t size() const { return m_num_events; }
+
+	static void write(std::string const& filename, PulseEventContainer const& events);
+	static void write(std::string const& filename, AlmostSortedPulseEvents const& events);
+
+private:
+	void flush();
+
+	std::ofstream m_stream;
+	std::string m_filename;
+	size_t const m_index_stride;
+
+	std::vector<SpikeFileRecord> m_buffer;
+	size_t m_num_events;
+	size_t m_dropped_events;
+	bool m_sorted;
+	PulseEvent m_last_event;
+
+	// per block maximum and minimum
+	std::vector<SpikeFileIndexEntry> m_index;
+};
+
+/**
+ * @brief Read-only access to a memory-mapped spike file.
+ *
+ * Opening the file only maps it, events are read on access.
+ */
+class SpikeFile : private boost::noncopyable
+{
+public:
+	/**
+	 * @throw std::runtime_error If the file can not be mapped or is not a
+	 *        valid spike file of a supported version.
+	 */
+	explicit SpikeFile(std::string const& filename);
+	~SpikeFile();
+
+	size_t size() const { return m_header->num_events; }
+	size_t dropped_events() const { return m_header->dropped_events; }
+	std::uint32_t version() const { return m_header->version; }
+
+	/// Whether the events were written sorted by time.
+	bool is_sorted() const { return m_header->flags & SpikeFileHeader::sorted; }
+
+	/// Events as stored in the mapped file.
+	SpikeFileRecord const* records() const { return m_records; }
+
+	PulseEvent operator[](size_t ii) const { return m_records[ii].event(); }
+
+	/**
+	 * @brief Range of events [first, second) which contains all events with
+	 *        time in [t_begin, t_end), in O(log n).
+	 *
+	 * For sorted files the range contains exactly these events. Otherwise it
+	 * is the smallest range of whole index blocks that may contain them.
+	 */
+	std::pair<size_t, size_t> time_range(
+		PulseEvent::spiketime_t t_begin, PulseEvent::spiketime_t t_end) const;
+
+	/// Copy of events with time in [t_begin, t_end), in order of storage.
+	AlmostSortedPulseEvents::container_type events(
+		PulseEvent::spiketime_t t_begin, PulseEvent::spiketime_t t_end) const;
+
+	AlmostSortedPulseEvents almost_sorted_events() const;
+	PulseEventContainer container() const;
+
+private:
+	void* m_mapping;
+	size_t m_mapping_size;
+
+	SpikeFileHeader const* m_header;
+	SpikeFileRecord const* m_records;
+	SpikeFileIndexEntry const* m_index;
+};
+
+} // namespace FPGA
+} // namespace HMF
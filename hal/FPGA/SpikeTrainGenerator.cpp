@@ -0,0 +1,214 @@
+#include "hal/FPGA/SpikeTrainGenerator.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+std::uint64_t splitmix64(std::uint64_t& state)
+{
+	std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return z ^ (z >> 31);
+}
+
+/**
+ * Four interleaved xorshift128+ generators, filling blocks of uniform numbers
+ * in (0, 1]. The lanes are independent, hence the inner loop vectorizes.
+ */
+class UniformBlockRng
+{
+public:
+	static size_t const lanes = 4;
+	static size_t const block_size = 64;
+
+	explicit UniformBlockRng(std::uint64_t seed)
+	{
+		for (size_t ll = 0; ll < lanes; ++ll) {
+			m_s0[ll] = splitmix64(seed);
+			m_s1[ll] = splitmix64(seed) | 1;
+		}
+	}
+
+	void fill(double* out)
+	{
+		for (size_t ii = 0; ii < block_size; ii += lanes) {
+			for (size_t ll = 0; ll < lanes; ++ll) {
+				std::uint64_t s1 = m_s0[ll];
+				std::uint64_t const s0 = m_s1[ll];
+				m_s0[ll] = s0;
+				s1 ^= s1 << 23;
+				m_s1[ll] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+				// upper 53 bits, shifted to (0, 1]
+				out[ii + ll] = ((m_s1[ll] + s0) >> 11) * (1. / 9007199254740992.) +
+				               (1. / 9007199254740992.);
+			}
+		}
+	}
+
+private:
+	std::uint64_t m_s0[lanes];
+	std::uint64_t m_s1[lanes];
+};
+
+size_t const UniformBlockRng::lanes;
+size_t const UniformBlockRng::block_size;
+
+} // namespace
+
+SpikeTrainGenerator::SpikeTrainGenerator(std::uint64_t const seed)
+	: m_seed(seed), m_sources(), m_has_release_limit(false), m_release_limit()
+{}
+
+void SpikeTrainGenerator::add(Source source, addresses_type const& addresses)
+{
+	for (auto const& address : addresses) {
+		source.address = address;
+		// independent stream per source
+		std::uint64_t state = m_seed ^ (m_sources.size() * 0xd1b54a32d192ed03ull);
+		source.seed = splitmix64(state);
+		m_sources.push_back(source);
+	}
+}
+
+void SpikeTrainGenerator::add_poisson(
+	addresses_type const& addresses,
+	double const rate,
+	spiketime_t const t_begin,
+	spiketime_t const t_end)
+{
+	if (!(rate >= 0))
+		throw std::invalid_argument("SpikeTrainGenerator: rate has to be non-negative");
+	if (rate == 0)
+		return;
+
+	Source source = {};
+	source.kind = Kind::poisson;
+	source.t_begin = t_begin;
+	source.t_end = t_end;
+	source.mean_interval = DNC_frequency_in_MHz * 1e6 / rate;
+	add(source, addresses);
+}
+
+void SpikeTrainGenerator::add_regular(
+	addresses_type const& addresses,
+	spiketime_t const period,
+	spiketime_t const t_begin,
+	spiketime_t const t_end,
+	spiketime_t const phase)
+{
+	if (period == 0)
+		throw std::invalid_argument("SpikeTrainGenerator: period has to be non-zero");
+
+	Source source = {};
+	source.kind = Kind::regular;
+	source.t_begin = t_begin;
+	source.t_end = t_end;
+	source.phase = phase;
+	source.period = period;
+	add(source, addresses);
+}
+
+void SpikeTrainGenerator::add_bursts(
+	addresses_type const& addresses,
+	spiketime_t const burst_period,
+	size_t const spikes_per_burst,
+	spiketime_t const interval,
+	spiketime_t const t_begin,
+	spiketime_t const t_end,
+	spiketime_t const phase)
+{
+	if (burst_period == 0 || interval == 0)
+		throw std::invalid_argument(
+			"SpikeTrainGenerator: burst period and interval have to be non-zero");
+
+	Source source = {};
+	source.kind = Kind::bursts;
+	source.t_begin = t_begin;
+	source.t_end = t_end;
+	source.phase = phase;
+	source.burst_period = burst_period;
+	source.spikes_per_burst = spikes_per_burst;
+	source.burst_interval = interval;
+	add(source, addresses);
+}
+
+void SpikeTrainGenerator::set_release_limit(ReleaseLimit const& limit)
+{
+	m_has_release_limit = true;
+	m_release_limit = limit;
+}
+
+void SpikeTrainGenerator::clear_release_limit()
+{
+	m_has_release_limit = false;
+}
+
+void SpikeTrainGenerator::generate(
+	Source const& source, PulseEventContainer::container_type& spikes)
+{
+	switch (source.kind) {
+		case Kind::poisson: {
+			UniformBlockRng rng(source.seed);
+			double uniform[UniformBlockRng::block_size];
+			double time = source.t_begin;
+			while (true) {
+				rng.fill(uniform);
+				for (size_t ii = 0; ii < UniformBlockRng::block_size; ++ii) {
+					time -= source.mean_interval * std::log(uniform[ii]);
+					if (!(time < source.t_end))
+						return;
+					spikes.push_back(PulseEvent(source.address, static_cast<spiketime_t>(time)));
+				}
+			}
+		}
+		case Kind::regular: {
+			for (spiketime_t time = source.t_begin + source.phase; time < source.t_end;
+			     time += source.period) {
+				spikes.push_back(PulseEvent(source.address, time));
+			}
+			return;
+		}
+		case Kind::bursts: {
+			for (spiketime_t start = source.t_begin + source.phase; start < source.t_end;
+			     start += source.burst_period) {
+				for (size_t ii = 0; ii < source.spikes_per_burst; ++ii) {
+					spiketime_t const time = start + ii * source.burst_interval;
+					if (time >= source.t_end)
+						break;
+					spikes.push_back(PulseEvent(source.address, time));
+				}
+			}
+			return;
+		}
+	}
+}
+
+PulseEventContainer SpikeTrainGenerator::generate(size_t& dropped_events) const
+{
+	std::vector<PulseEventContainer::container_type> streams(m_sources.size());
+	for (size_t ii = 0; ii < m_sources.size(); ++ii) {
+		generate(m_sources[ii], streams[ii]);
+	}
+	// k-way merge of the sorted streams
+	PulseEventContainer spikes(streams);
+
+	dropped_events = 0;
+	if (m_has_release_limit) {
+		return m_release_limit.apply(spikes, dropped_events);
+	}
+	return spikes;
+}
+
+PulseEventContainer SpikeTrainGenerator::generate() const
+{
+	size_t dropped_events;
+	return generate(dropped_events);
+}
+
+} // namespace FPGA
+} // namespace HMF
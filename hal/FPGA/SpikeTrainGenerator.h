@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hal/FPGAContainer.h"
+#include "hal/FPGA/ReleaseLimit.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Generator of stimulus spike trains.
+ *
+ * Each added source (one address of a Poisson, regular or burst train) is
+ * generated as a separate time-sorted stream, all streams are combined by a
+ * k-way merge. The random streams of different sources are independent and
+ * only depend on the seed and the order in which sources were added.
+ *
+ * Times are given in DNC clock cycles (DNC_frequency_in_MHz), rates in Hz
+ * w.r.t. this clock, i.e. in hardware time.
+ */
+class SpikeTrainGenerator
+{
+public:
+	typedef PulseEvent::spiketime_t spiketime_t;
+	typedef std::vector<PulseAddress> addresses_type;
+
+	explicit SpikeTrainGenerator(std::uint64_t seed = 0);
+
+	/**
+	 * @brief Poisson trains of @a rate for all @a addresses in [t_begin, t_end).
+	 * @throw std::invalid_argument If @a rate is negative.
+	 */
+	void add_poisson(
+		addresses_type const& addresses, double rate, spiketime_t t_begin, spiketime_t t_end);
+
+	/**
+	 * @brief Spikes at t_begin + phase + k * period in [t_begin, t_end) for all @a addresses.
+	 * @throw std::invalid_argument If @a period is zero.
+	 */
+	void add_regular(
+		addresses_type const& addresses,
+		spiketime_t period,
+		spiketime_t t_begin,
+		spiketime_t t_end,
+		spiketime_t phase = 0);
+
+	/**
+	 * @brief Bursts of @a spikes_per_burst spikes @a interval apart, starting
+	 *        every @a burst_period from t_begin + phase, in [t_begin, t_end).
+	 * @throw std::invalid_argument If @a burst_period or @a interval is zero.
+	 */
+	void add_bursts(
+		addresses_type const& addresses,
+		spiketime_t burst_period,
+		size_t spikes_per_burst,
+		spiketime_t interval,
+		spiketime_t t_begin,
+		spiketime_t t_end,
+		spiketime_t phase = 0);
+
+	/// Only keep spikes released in time by the FPGA (see ReleaseLimit).
+	void set_release_limit(ReleaseLimit const& limit);
+	void clear_release_limit();
+
+	/// Number of sources added so far.
+	size_t num_sources() const { return m_sources.size(); }
+
+	/**
+	 * @brief All spikes of all sources, sorted by time.
+	 * @param dropped_events Number of spikes dropped due to the release limit.
+	 */
+	PulseEventContainer generate(size_t& dropped_events) const;
+	PulseEventContainer generate() const;
+
+private:
+	enum class Kind
+	{
+		poisson,
+		regular,
+		bursts
+	};
+
+	struct Source
+	{
+		Kind kind;
+		PulseAddress address;
+		std::uint64_t seed;
+		spiketime_t t_begin;
+		spiketime_t t_end;
+		spiketime_t phase;
+		// poisson: mean inter-spike interval in clock cycles
+		double mean_interval;
+		// regular
+		spiketime_t period;
+		// bursts: onsets every burst_period, spikes within a burst burst_interval apart
+		spiketime_t burst_period;
+		size_t spikes_per_burst;
+		spiketime_t burst_interval;
+	};
+
+	void add(Source source, addresses_type const& addresses);
+	static void generate(Source const& source, PulseEventContainer::container_type& spikes);
+
+	std::uint64_t m_seed;
+	std::vector<Source> m_sources;
+	bool m_has_release_limit;
+	ReleaseLimit m_release_limit;
+};
+
+} // namespace FPGA
+} // namespace HMF
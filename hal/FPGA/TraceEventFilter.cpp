@@ -0,0 +1,102 @@
+#include "hal/FPGA/TraceEventFilter.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace HMF {
+namespace FPGA {
+
+size_t const TraceEventFilter::num_links;
+size_t const TraceEventFilter::link_shift;
+
+TraceEventFilter::TraceEventFilter()
+	: m_labels(), m_links(), m_t_begin(0), m_t_end(std::numeric_limits<spiketime_t>::max())
+{
+	m_labels.set();
+	m_links.set();
+}
+
+void TraceEventFilter::allow_all_labels()
+{
+	m_labels.set();
+}
+
+void TraceEventFilter::deny_all_labels()
+{
+	m_labels.reset();
+}
+
+void TraceEventFilter::set_label_allowed(label_t const label, bool const allowed)
+{
+	if (label >= PulseAddress::num_labels)
+		throw std::out_of_range("TraceEventFilter: invalid label");
+	m_labels.set(label, allowed);
+}
+
+bool TraceEventFilter::is_label_allowed(label_t const label) const
+{
+	if (label >= PulseAddress::num_labels)
+		throw std::out_of_range("TraceEventFilter: invalid label");
+	return m_labels.test(label);
+}
+
+void TraceEventFilter::drop_background_events()
+{
+	for (size_t label = 0; label < PulseAddress::num_labels; label += HICANN::L1Address::max + 1) {
+		m_labels.reset(label);
+	}
+}
+
+void TraceEventFilter::set_link_selected(
+	PulseAddress::chip_address_t const& chip,
+	PulseAddress::channel_t const& channel,
+	bool const selected)
+{
+	m_links.set(link(chip, channel), selected);
+}
+
+bool TraceEventFilter::is_link_selected(
+	PulseAddress::chip_address_t const& chip, PulseAddress::channel_t const& channel) const
+{
+	return m_links.test(link(chip, channel));
+}
+
+size_t TraceEventFilter::link(
+	PulseAddress::chip_address_t const& chip, PulseAddress::channel_t const& channel)
+{
+	PulseAddress address(0);
+	address.setChipAddress(chip);
+	address.setChannel(channel);
+	return link(address.getLabel());
+}
+
+void TraceEventFilter::set_time_window(spiketime_t const t_begin, spiketime_t const t_end)
+{
+	if (t_begin > t_end)
+		throw std::invalid_argument("TraceEventFilter: time window ends before it begins");
+	m_t_begin = t_begin;
+	m_t_end = t_end;
+}
+
+bool TraceEventFilter::accepts_all() const
+{
+	return m_labels.all() && m_links.all() && m_t_begin == 0 &&
+	       m_t_end == std::numeric_limits<spiketime_t>::max();
+}
+
+bool TraceEventFilter::operator==(TraceEventFilter const& other) const
+{
+	return m_labels == other.m_labels && m_links == other.m_links &&
+	       m_t_begin == other.m_t_begin && m_t_end == other.m_t_end;
+}
+
+TraceEventFilter background_filter(bool const drop_background_events)
+{
+	TraceEventFilter filter;
+	if (drop_background_events)
+		filter.drop_background_events();
+	return filter;
+}
+
+} // namespace FPGA
+} // namespace HMF
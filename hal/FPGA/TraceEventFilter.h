@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/serialization/bitset.hpp>
+#include <boost/serialization/nvp.hpp>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Selection of trace pulse events, applied while decoding the trace.
+ *
+ * An event is accepted if its label is allowed, its link (HICANN and Gbit
+ * link part of the label) is selected and its time lies within the time window.
+ * The DNC part of trace labels is always zero, links are hence selected for
+ * all DNCs at once.
+ * Rejected events are counted as dropped events. By default all events are
+ * accepted.
+ */
+class TraceEventFilter
+{
+public:
+	typedef PulseAddress::label_t label_t;
+	typedef PulseEvent::spiketime_t spiketime_t;
+
+	/// Number of links, i.e. combinations of HICANN on DNC and Gbit link.
+	static const size_t num_links = 64;
+
+	TraceEventFilter();
+
+	void allow_all_labels();
+	void deny_all_labels();
+	void set_label_allowed(label_t label, bool allowed);
+	bool is_label_allowed(label_t label) const;
+
+	/// Denies all labels with L1 address zero (background events).
+	void drop_background_events();
+
+	void set_link_selected(
+		PulseAddress::chip_address_t const& chip,
+		PulseAddress::channel_t const& channel,
+		bool selected);
+	bool is_link_selected(
+		PulseAddress::chip_address_t const& chip, PulseAddress::channel_t const& channel) const;
+
+	/// Index of the link of @a label in [0, num_links).
+	static size_t link(label_t const label) { return (label >> link_shift) & (num_links - 1); }
+
+	/// Only accept events with time in [t_begin, t_end).
+	void set_time_window(spiketime_t t_begin, spiketime_t t_end);
+	spiketime_t get_time_window_begin() const { return m_t_begin; }
+	spiketime_t get_time_window_end() const { return m_t_end; }
+
+	bool accepts(label_t const label, spiketime_t const time) const
+	{
+		return m_labels[label & (PulseAddress::num_labels - 1)] &&
+		       m_links[link(label)] && time >= m_t_begin &&
+		       time < m_t_end;
+	}
+	bool accepts(PulseEvent const& event) const
+	{
+		return accepts(event.getLabel(), event.getTime());
+	}
+
+	/// Whether all events are accepted.
+	bool accepts_all() const;
+
+	bool operator==(TraceEventFilter const& other) const;
+	bool operator!=(TraceEventFilter const& other) const { return !(*this == other); }
+
+private:
+	static const size_t link_shift = 6;
+	static size_t link(
+		PulseAddress::chip_address_t const& chip, PulseAddress::channel_t const& channel);
+
+	std::bitset<PulseAddress::num_labels> m_labels;
+	std::bitset<num_links> m_links;
+	spiketime_t m_t_begin;
+	spiketime_t m_t_end;
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, unsigned int const)
+	{
+		using namespace boost::serialization;
+		// clang-format off
+		ar & make_nvp("labels", m_labels)
+		   & make_nvp("links", m_links)
+		   & make_nvp("t_begin", m_t_begin)
+		   & make_nvp("t_end", m_t_end);
+		// clang-format on
+	}
+};
+
+/// Filter accepting all events, except for background events if @a drop_background_events.
+TraceEventFilter background_filter(bool drop_background_events);
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,132 @@
+#include "hal/FPGA/TraceReducers.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+/// Index of the label of @a event into per-label arrays, cf. PulseEventContainer::build_label_index().
+inline size_t label_index(PulseEvent const& event)
+{
+	return event.getLabel() & (PulseAddress::num_labels - 1);
+}
+
+/// Checks a label passed to an accessor, cf. PulseEventContainer::positions_of().
+inline size_t checked_label(PulseAddress::label_t const label, char const* const reducer)
+{
+	if (label >= PulseAddress::num_labels)
+		throw std::out_of_range(std::string(reducer) + ": invalid label");
+	return label;
+}
+
+} // namespace
+
+TracePulseReducer::~TracePulseReducer() {}
+
+////////////////////////////////////////////////////////////////////////////////
+// SpikeCounter
+
+SpikeCounter::SpikeCounter() : m_counts(PulseAddress::num_labels, 0) {}
+
+std::uint64_t SpikeCounter::count(PulseAddress::label_t const label) const
+{
+	return m_counts[checked_label(label, "SpikeCounter")];
+}
+
+std::uint64_t SpikeCounter::total() const
+{
+	return std::accumulate(m_counts.begin(), m_counts.end(), std::uint64_t(0));
+}
+
+void SpikeCounter::do_reduce(PulseEvent const* begin, PulseEvent const* const end)
+{
+	for (; begin != end; ++begin)
+		++m_counts[label_index(*begin)];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// BinnedSpikeCounter
+
+BinnedSpikeCounter::BinnedSpikeCounter(
+	PulseEvent::spiketime_t const bin_width,
+	size_t const num_bins,
+	PulseEvent::spiketime_t const t_begin)
+	: m_bin_width(bin_width),
+	  m_num_bins(num_bins),
+	  m_t_begin(t_begin),
+	  m_counts(),
+	  m_out_of_range(0)
+{
+	if (m_bin_width == 0 || m_num_bins == 0)
+		throw std::invalid_argument("BinnedSpikeCounter: bin width and number of bins have to be non-zero");
+	m_counts.assign(PulseAddress::num_labels * m_num_bins, 0);
+}
+
+std::uint32_t BinnedSpikeCounter::count(PulseAddress::label_t const label, size_t const bin) const
+{
+	size_t const index = checked_label(label, "BinnedSpikeCounter");
+	if (bin >= m_num_bins)
+		throw std::out_of_range("BinnedSpikeCounter: invalid bin");
+	return m_counts[index * m_num_bins + bin];
+}
+
+double BinnedSpikeCounter::rate(PulseAddress::label_t const label, size_t const bin) const
+{
+	return count(label, bin) * (DNC_frequency_in_MHz * 1e6) / m_bin_width;
+}
+
+void BinnedSpikeCounter::do_reduce(PulseEvent const* begin, PulseEvent const* const end)
+{
+	for (; begin != end; ++begin) {
+		PulseEvent::spiketime_t const time = begin->getTime();
+		PulseEvent::spiketime_t const bin = (time - m_t_begin) / m_bin_width;
+		if (time < m_t_begin || bin >= m_num_bins) {
+			++m_out_of_range;
+			continue;
+		}
+		++m_counts[label_index(*begin) * m_num_bins + bin];
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// FirstLastSpikeTimes
+
+FirstLastSpikeTimes::FirstLastSpikeTimes()
+	: m_first(PulseAddress::num_labels, std::numeric_limits<PulseEvent::spiketime_t>::max()),
+	  m_last(PulseAddress::num_labels, 0)
+{}
+
+bool FirstLastSpikeTimes::has_spikes(PulseAddress::label_t const label) const
+{
+	size_t const index = checked_label(label, "FirstLastSpikeTimes");
+	return m_first[index] <= m_last[index];
+}
+
+PulseEvent::spiketime_t FirstLastSpikeTimes::first(PulseAddress::label_t const label) const
+{
+	return m_first[checked_label(label, "FirstLastSpikeTimes")];
+}
+
+PulseEvent::spiketime_t FirstLastSpikeTimes::last(PulseAddress::label_t const label) const
+{
+	return m_last[checked_label(label, "FirstLastSpikeTimes")];
+}
+
+void FirstLastSpikeTimes::do_reduce(PulseEvent const* begin, PulseEvent const* const end)
+{
+	for (; begin != end; ++begin) {
+		size_t const label = label_index(*begin);
+		PulseEvent::spiketime_t const time = begin->getTime();
+		m_first[label] = std::min(m_first[label], time);
+		m_last[label] = std::max(m_last[label], time);
+	}
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hal/FPGAContainer.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Aggregates pulse events while they are decoded from the trace memory.
+ *
+ * Reducers are handed the events of each received packet in order of arrival,
+ * i.e. almost sorted by time (events of the same label are sorted). Attached to
+ * the readout (see reduce_trace_pulses()) the events need not be stored at all.
+ */
+class TracePulseReducer
+{
+public:
+	typedef AlmostSortedPulseEvents::container_type container_type;
+
+	virtual ~TracePulseReducer();
+
+	void reduce(PulseEvent const* begin, PulseEvent const* end) { do_reduce(begin, end); }
+	void reduce(container_type const& events)
+	{
+		do_reduce(events.data(), events.data() + events.size());
+	}
+
+protected:
+	virtual void do_reduce(PulseEvent const* begin, PulseEvent const* end) = 0;
+};
+
+/**
+ * @brief Number of pulse events per label.
+ */
+class SpikeCounter : public TracePulseReducer
+{
+public:
+	SpikeCounter();
+
+	/// @throw std::out_of_range If @a label is not a valid 14 bit label.
+	std::uint64_t count(PulseAddress::label_t label) const;
+
+	/// Counts indexed by label.
+	std::vector<std::uint64_t> const& counts() const { return m_counts; }
+
+	/// Number of all pulse events.
+	std::uint64_t total() const;
+
+protected:
+	void do_reduce(PulseEvent const* begin, PulseEvent const* end) override;
+
+private:
+	std::vector<std::uint64_t> m_counts;
+};
+
+/**
+ * @brief Number of pulse events per label and time bin.
+ *
+ * Bin @c b covers [t_begin + b * bin_width, t_begin + (b + 1) * bin_width).
+ * The counts of all labels are held (num_labels * num_bins 32 bit counters),
+ * events outside of the binned interval are only counted in total.
+ */
+class BinnedSpikeCounter : public TracePulseReducer
+{
+public:
+	/**
+	 * @param bin_width Width of the bins in DNC clock cycles.
+	 * @throw std::invalid_argument If @a bin_width or @a num_bins is zero.
+	 */
+	BinnedSpikeCounter(
+		PulseEvent::spiketime_t bin_width, size_t num_bins, PulseEvent::spiketime_t t_begin = 0);
+
+	PulseEvent::spiketime_t bin_width() const { return m_bin_width; }
+	size_t num_bins() const { return m_num_bins; }
+	PulseEvent::spiketime_t t_begin() const { return m_t_begin; }
+
+	/// @throw std::out_of_range If @a label is not a valid 14 bit label or @a bin >= num_bins().
+	std::uint32_t count(PulseAddress::label_t label, size_t bin) const;
+
+	/// Firing rate in Hz (w.r.t. DNC time, cf. DNC_frequency_in_MHz) of @a label in @a bin, cf. count().
+	double rate(PulseAddress::label_t label, size_t bin) const;
+
+	/// Counts of all labels, label-major, i.e. indexed by label * num_bins() + bin.
+	std::vector<std::uint32_t> const& counts() const { return m_counts; }
+
+	/// Number of pulse events not within any bin.
+	std::uint64_t out_of_range() const { return m_out_of_range; }
+
+protected:
+	void do_reduce(PulseEvent const* begin, PulseEvent const* end) override;
+
+private:
+	PulseEvent::spiketime_t const m_bin_width;
+	size_t const m_num_bins;
+	PulseEvent::spiketime_t const m_t_begin;
+	std::vector<std::uint32_t> m_counts;
+	std::uint64_t m_out_of_range;
+};
+
+/**
+ * @brief Time of the first and last pulse event per label.
+ */
+class FirstLastSpikeTimes : public TracePulseReducer
+{
+public:
+	FirstLastSpikeTimes();
+
+	/// @throw std::out_of_range If @a label is not a valid 14 bit label, as for first() and last().
+	bool has_spikes(PulseAddress::label_t label) const;
+
+	/// @note Only meaningful if has_spikes(label).
+	PulseEvent::spiketime_t first(PulseAddress::label_t label) const;
+	PulseEvent::spiketime_t last(PulseAddress::label_t label) const;
+
+protected:
+	void do_reduce(PulseEvent const* begin, PulseEvent const* end) override;
+
+private:
+	std::vector<PulseEvent::spiketime_t> m_first;
+	std::vector<PulseEvent::spiketime_t> m_last;
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -12,12 +12,117 @@
 
 namespace {
 
-template <typename ForwardIt>
-void insertion_sort(ForwardIt beg, ForwardIt end)
+using HMF::FPGA::PulseEvent;
+
+typedef std::vector<PulseEvent> event_vector;
+
+/**
+ * Sorts pulse events of which each one is late by a bounded amount w.r.t. the
+ * preceding ones, as it is the case for the interleaved per-link streams of
+ * the trace memory (at most one 15-bit timestamp window).
+ *
+ * Sorted stretches are skipped, unsorted ones are processed block-wise: each
+ * block is sorted and merged with the tail of the sorted prefix it overlaps
+ * with. Due to the disorder bound this tail is short. The block size follows
+ * the tail length, hence the sort is linear in the number of events for
+ * bounded disorder and degrades gracefully to O(n log n) otherwise.
+ */
+void bounded_disorder_sort(event_vector& events)
+{
+	static size_t const min_block_size = 1 << 12;
+
+	auto const begin = events.begin();
+	auto const end = events.end();
+	auto sorted_end = std::is_sorted_until(begin, end);
+
+	event_vector buffer;
+	size_t block_size = min_block_size;
+	while (sorted_end != end) {
+		auto const block_end =
+		    sorted_end + std::min(block_size, static_cast<size_t>(end - sorted_end));
+		std::sort(sorted_end, block_end);
+
+		// Merge block with overlapping tail of sorted prefix, the tail is moved
+		// out of the way so that the merge can be done in place.
+		auto const tail = std::upper_bound(begin, sorted_end, *sorted_end);
+		buffer.assign(tail, sorted_end);
+		auto out = tail;
+		auto left = buffer.cbegin();
+		auto right = sorted_end;
+		while (left != buffer.cend() && right != block_end) {
+			*out++ = (*right < *left) ? *right++ : *left++;
+		}
+		std::copy(left, buffer.cend(), out);
+
+		block_size = std::max(min_block_size, 2 * buffer.size());
+		sorted_end = std::is_sorted_until(block_end - 1, end);
+	}
+}
+
+/**
+ * Merges sorted sequences of pulse events by repeatedly taking the earliest
+ * head of all sequences from a heap.
+ */
+void kway_merge(std::vector<event_vector const*> const& inputs, event_vector& output)
 {
-	for (auto it = beg; it != end; ++it) {
-		auto const insertion = std::upper_bound(beg, it, *it);
-		std::rotate(insertion, it, std::next(it));
+	typedef std::pair<event_vector::const_iterator, event_vector::const_iterator> range_type;
+
+	std::vector<range_type> heap;
+	size_t total = 0;
+	for (auto const* input : inputs) {
+		total += input->size();
+		if (!input->empty()) {
+			heap.emplace_back(input->cbegin(), input->cend());
+		}
+	}
+
+	output.clear();
+	output.reserve(total);
+
+	auto const later = [](range_type const& a, range_type const& b) {
+		return *b.first < *a.first;
+	};
+	std::make_heap(heap.begin(), heap.end(), later);
+
+	while (heap.size() > 1) {
+		std::pop_heap(heap.begin(), heap.end(), later);
+		range_type& range = heap.back();
+		output.push_back(*range.first);
+		if (++range.first == range.second) {
+			heap.pop_back();
+		} else {
+			std::push_heap(heap.begin(), heap.end(), later);
+		}
+	}
+
+	if (!heap.empty()) {
+		output.insert(output.end(), heap.front().first, heap.front().second);
+	}
+}
+
+/**
+ * Merges the sorted @a batch into the sorted @a events in place, back to front.
+ * Events of @a batch are placed after equal ones of @a events. Needs at most a
+ * single reallocation of @a events and no further buffer.
+ */
+void merge_into(event_vector& events, event_vector const& batch)
+{
+	if (batch.empty()) {
+		return;
+	}
+
+	size_t const size = events.size();
+	events.resize(size + batch.size());
+
+	auto out = events.end();
+	auto existing = events.begin() + size;
+	auto incoming = batch.end();
+	while (incoming != batch.begin()) {
+		if (existing != events.begin() && *(incoming - 1) < *(existing - 1)) {
+			*--out = *--existing;
+		} else {
+			*--out = *--incoming;
+		}
 	}
 }
 
@@ -228,48 +333,153 @@ AlmostSortedPulseEvents::AlmostSortedPulseEvents(container_type&& events_, size_
 ////////////////////////////////////////////////////////////////////////////////
 // PulseEventContainer
 
-PulseEventContainer::PulseEventContainer() : m_events()
+PulseEventContainer::PulseEventContainer()
+	: m_events(),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
 {
 }
 
 PulseEventContainer::PulseEventContainer(container_type const& data, bool const is_almost_sorted)
-	: m_events(data)
+	: m_events(data),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
 {
 	sort(is_almost_sorted);
 }
 
 PulseEventContainer::PulseEventContainer(container_type&& data, bool const is_almost_sorted)
-	: m_events(std::move(data))
+	: m_events(std::move(data)),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
 {
 	sort(is_almost_sorted);
 }
 
 PulseEventContainer::PulseEventContainer(AlmostSortedPulseEvents const& data)
-	: m_events(data.events)
+	: m_events(data.events),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
 {
 	sort(true);
 }
 
 PulseEventContainer::PulseEventContainer(AlmostSortedPulseEvents&& data)
-	: m_events(std::move(data.events))
+	: m_events(std::move(data.events)),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
 {
 	sort(true);
 }
 
+PulseEventContainer::PulseEventContainer(std::vector<container_type> const& per_link_data)
+	: m_events(),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
+{
+	std::vector<container_type> sorted_copies;
+	sorted_copies.reserve(per_link_data.size());
+
+	std::vector<container_type const*> inputs;
+	inputs.reserve(per_link_data.size());
+	for (auto const& data : per_link_data) {
+		if (std::is_sorted(data.begin(), data.end())) {
+			inputs.push_back(&data);
+		} else {
+			sorted_copies.push_back(data);
+			bounded_disorder_sort(sorted_copies.back());
+			inputs.push_back(&sorted_copies.back());
+		}
+	}
+
+	kway_merge(inputs, m_events);
+}
+
+PulseEventContainer::PulseEventContainer(std::vector<PulseEventContainer> const& containers)
+	: m_events(),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
+{
+	std::vector<container_type const*> inputs;
+	inputs.reserve(containers.size());
+	for (auto const& container : containers) {
+		inputs.push_back(&container.m_events);
+	}
+
+	kway_merge(inputs, m_events);
+}
+
+PulseEventContainer::PulseEventContainer(std::vector<PulseEventContainer const*> const& containers)
+	: m_events(),
+	  m_label_index_valid(false),
+	  m_label_offsets(),
+	  m_label_positions()
+{
+	std::vector<container_type const*> inputs;
+	inputs.reserve(containers.size());
+	for (auto const* container : containers) {
+		inputs.push_back(&container->m_events);
+	}
+
+	kway_merge(inputs, m_events);
+}
+
 void PulseEventContainer::clear()
 {
 	m_events.clear();
+	invalidate_label_index();
 }
 
 void PulseEventContainer::insert_sorted(PulseEvent const& event)
 {
 	m_events.insert(std::upper_bound(m_events.begin(), m_events.end(), event), event);
+	invalidate_label_index();
+}
+
+void PulseEventContainer::insert_range(container_type const& events, bool const is_almost_sorted)
+{
+	// inserting the own events (e.g. c.insert_range(c.data())) requires a copy, cf. merge()
+	if (&events != &m_events && std::is_sorted(events.begin(), events.end())) {
+		merge_into(m_events, events);
+		invalidate_label_index();
+		return;
+	}
+	insert_range(container_type(events), is_almost_sorted);
+}
+
+void PulseEventContainer::insert_range(container_type&& events, bool const is_almost_sorted)
+{
+	if (is_almost_sorted) {
+		bounded_disorder_sort(events);
+	} else if (!std::is_sorted(events.begin(), events.end())) {
+		std::sort(events.begin(), events.end());
+	}
+	merge_into(m_events, events);
+	invalidate_label_index();
+}
+
+void PulseEventContainer::merge(PulseEventContainer const& other)
+{
+	if (&other == this) {
+		merge_into(m_events, container_type(other.m_events));
+	} else {
+		merge_into(m_events, other.m_events);
+	}
+	invalidate_label_index();
 }
 
 void PulseEventContainer::append(PulseEvent const& event)
 {
 	if (m_events.empty() || m_events.back().getTime() <= event.getTime()) {
 		m_events.push_back(event);
+		invalidate_label_index();
 		return;
 	}
 	throw std::invalid_argument("can not append earlier event to sorted pulse event container");
@@ -283,12 +493,73 @@ size_t PulseEventContainer::size() const
 void PulseEventContainer::sort(bool const is_almost_sorted)
 {
 	if (is_almost_sorted) {
-		insertion_sort(m_events.begin(), m_events.end());
+		bounded_disorder_sort(m_events);
 	} else {
 		std::sort(m_events.begin(), m_events.end());
 	}
 }
 
+PulseEventContainer::event_range PulseEventContainer::time_range(
+	PulseEvent::spiketime_t const t_begin, PulseEvent::spiketime_t const t_end) const
+{
+	auto const earlier = [](PulseEvent const& event, PulseEvent::spiketime_t const time) {
+		return event.getTime() < time;
+	};
+	auto const begin = std::lower_bound(m_events.begin(), m_events.end(), t_begin, earlier);
+	auto const end = std::lower_bound(begin, m_events.end(), std::max(t_begin, t_end), earlier);
+	return event_range(begin, end);
+}
+
+PulseEventContainer::position_range PulseEventContainer::positions_of(
+	PulseAddress::label_t const label) const
+{
+	if (label >= PulseAddress::num_labels) {
+		throw std::out_of_range("PulseEventContainer: invalid label");
+	}
+	if (!m_label_index_valid) {
+		build_label_index();
+	}
+	size_t const* const positions = m_label_positions.data();
+	return position_range(
+		positions + m_label_offsets[label], positions + m_label_offsets[label + 1]);
+}
+
+std::vector<PulseEvent::spiketime_t> PulseEventContainer::times_of(
+	PulseAddress::label_t const label) const
+{
+	auto const positions = positions_of(label);
+	std::vector<PulseEvent::spiketime_t> times;
+	times.reserve(positions.second - positions.first);
+	for (auto it = positions.first; it != positions.second; ++it) {
+		times.push_back(m_events[*it].getTime());
+	}
+	return times;
+}
+
+void PulseEventContainer::invalidate_label_index()
+{
+	m_label_index_valid = false;
+}
+
+void PulseEventContainer::build_label_index() const
+{
+	// counting sort of the positions by label
+	m_label_offsets.assign(PulseAddress::num_labels + 1, 0);
+	for (auto const& event : m_events) {
+		++m_label_offsets[(event.getLabel() & (PulseAddress::num_labels - 1)) + 1];
+	}
+	for (size_t label = 0; label < PulseAddress::num_labels; ++label) {
+		m_label_offsets[label + 1] += m_label_offsets[label];
+	}
+
+	m_label_positions.resize(m_events.size());
+	std::vector<size_t> next(m_label_offsets.begin(), m_label_offsets.end() - 1);
+	for (size_t ii = 0; ii < m_events.size(); ++ii) {
+		m_label_positions[next[m_events[ii].getLabel() & (PulseAddress::num_labels - 1)]++] = ii;
+	}
+	m_label_index_valid = true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // SpinnakerEventContainer
 
@@ -4,6 +4,7 @@
 #include "hal/Coordinate/HMFGeometry.h"
 
 #include <bitset>
+#include <utility>
 #include <vector>
 
 #include <boost/serialization/vector.hpp>
@@ -450,6 +451,24 @@ public:
 #ifndef PYPLUSPLUS
 	PulseEventContainer(container_type&& data, bool is_almost_sorted = false);
 	PulseEventContainer(AlmostSortedPulseEvents&& data);
+
+	/**
+	 * @brief Merges the pulse events of several links (e.g. the HICANNs of a reticle).
+	 * @param per_link_data Pulse events of each link, these are expected to be
+	 *        (almost) sorted by time.
+	 */
+	explicit PulseEventContainer(std::vector<container_type> const& per_link_data);
+
+	/**
+	 * @brief Merges several containers into a single one sorted by time.
+	 */
+	explicit PulseEventContainer(std::vector<PulseEventContainer> const& containers);
+
+	/**
+	 * @brief Merges several containers into a single one sorted by time, without
+	 *        copying them into a vector first.
+	 */
+	explicit PulseEventContainer(std::vector<PulseEventContainer const*> const& containers);
 #endif // !PYPLUSPLUS
 
 	void clear();
@@ -459,6 +478,24 @@ public:
 	 */
 	void insert_sorted(PulseEvent const& event);
 
+	/**
+	 * @brief Insert a batch of pulse events, preserving container invariant.
+	 * The batch is sorted and merged in O(n + m) with at most one reallocation,
+	 * hence this should be preferred over repeated insert_sorted().
+	 * Inserted events are placed after equal ones already contained.
+	 * @param is_almost_sorted Whether the batch is almost sorted (see
+	 *        AlmostSortedPulseEvents), which allows for a faster sort.
+	 */
+	void insert_range(container_type const& events, bool is_almost_sorted = false);
+#ifndef PYPLUSPLUS
+	void insert_range(container_type&& events, bool is_almost_sorted = false);
+#endif // !PYPLUSPLUS
+
+	/**
+	 * @brief Merge the pulse events of another container in O(n + m).
+	 */
+	void merge(PulseEventContainer const& other);
+
 	/**
 	 * @brief Append pulse event to container.
 	 * @throw std::invalid_argument If container invariant would not be preserved.
@@ -471,11 +508,44 @@ public:
 
 	container_type const& data() const { return m_events; }
 
+#ifndef PYPLUSPLUS
+	typedef std::pair<container_type::const_iterator, container_type::const_iterator> event_range;
+	typedef std::pair<size_t const*, size_t const*> position_range;
+
+	/**
+	 * @brief Events with time in [t_begin, t_end), found by binary search.
+	 * The range is invalidated by modifications of the container.
+	 */
+	event_range time_range(PulseEvent::spiketime_t t_begin, PulseEvent::spiketime_t t_end) const;
+
+	/**
+	 * @brief Positions of all events with @a label, in ascending order.
+	 *
+	 * The positions of all labels are held in a compressed sparse row index,
+	 * which is built in O(n) on first use and kept until the container is
+	 * modified. The range is invalidated by modifications of the container.
+	 * @note Building the index is not thread-safe, concurrent readers have to
+	 *       call this once beforehand.
+	 */
+	position_range positions_of(PulseAddress::label_t label) const;
+#endif // !PYPLUSPLUS
+
+	/// Times of all events with @a label, uses the label index.
+	std::vector<PulseEvent::spiketime_t> times_of(PulseAddress::label_t label) const;
+
 private:
 	void sort(bool is_almost_sorted);
+	void invalidate_label_index();
+	void build_label_index() const;
 
 	container_type m_events;
 
+	// lazily built label index: the positions of events with label l are
+	// m_label_positions[m_label_offsets[l], m_label_offsets[l + 1])
+	mutable bool m_label_index_valid;
+	mutable std::vector<size_t> m_label_offsets;
+	mutable std::vector<size_t> m_label_positions;
+
 	friend class boost::serialization::access;
 	template<typename Archiver>
 	void serialize(Archiver& ar, const unsigned int)
@@ -484,6 +554,9 @@ private:
 		// clang-format off
 		ar & make_nvp("events", m_events);
 		// clang-format on
+		if (Archiver::is_loading::value) {
+			invalidate_label_index();
+		}
 	}
 };
 
@@ -13,6 +13,7 @@
 #include "hal/HICANN/FGInstruction.h"
 #include "hal/HICANN/FGStimulus.h"
 #include "hal/HICANN/GbitLink.h"
+#include "hal/HICANN/HICANNConfig.h"
 #include "hal/HICANN/L1Address.h"
 #include "hal/HICANN/Merger.h"
 #include "hal/HICANN/MergerTree.h"
@@ -0,0 +1,39 @@
+#include "hal/HICANN/HICANNConfig.h"
+
+using namespace HMF::Coordinate;
+
+namespace HMF {
+namespace HICANN {
+
+HICANNConfig::HICANNConfig() :
+	decoders(SynapseDriverOnHICANN::size),
+	weights(SynapseRowOnHICANN::size)
+{}
+
+bool HICANNConfig::operator==(HICANNConfig const& other) const
+{
+	return crossbar == other.crossbar
+		&& synapse_switches == other.synapse_switches
+		&& vertical_repeaters == other.vertical_repeaters
+		&& horizontal_repeaters == other.horizontal_repeaters
+		&& repeater_blocks == other.repeater_blocks
+		&& synapse_drivers == other.synapse_drivers
+		&& decoders == other.decoders
+		&& weights == other.weights
+		&& denmem_quads == other.denmem_quads
+		&& neuron_config == other.neuron_config
+		&& merger_tree == other.merger_tree
+		&& dnc_mergers == other.dnc_mergers
+		&& phase == other.phase
+		&& background_generators == other.background_generators
+		&& fg_config == other.fg_config
+		&& floating_gates == other.floating_gates;
+}
+
+bool HICANNConfig::operator!=(HICANNConfig const& other) const
+{
+	return !(*this == other);
+}
+
+} // HICANN
+} // HMF
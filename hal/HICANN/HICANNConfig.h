@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <boost/serialization/array.h>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "hal/Coordinate/HMFGeometry.h"
+#include "hal/HICANNContainer.h"
+#include "hal/HICANN/Crossbar.h"
+#include "hal/HICANN/DNCMergerLine.h"
+#include "hal/HICANN/FGConfig.h"
+#include "hal/HICANN/FGControl.h"
+#include "hal/HICANN/MergerTree.h"
+#include "hal/HICANN/SynapseDriver.h"
+#include "hal/HICANN/SynapseSwitch.h"
+
+namespace HMF {
+namespace HICANN {
+
+/**
+ * Complete configuration of a single HICANN, written at once by
+ * HICANN::apply(Handle::HICANN&, HICANNConfig const&).
+ *
+ * Holds the containers of the single backend setters. Arrays are indexed by
+ * the enum of their coordinate, e.g. weights[SynapseRowOnHICANN::toEnum()].
+ *
+ * @note Analog outputs, Gbit links and STDP are not part of the configuration.
+ */
+struct HICANNConfig
+{
+	HICANNConfig();
+
+	PYPP_DEFAULT(HICANNConfig(HICANNConfig const&));
+	PYPP_DEFAULT(HICANNConfig& operator=(HICANNConfig const&));
+
+	// Layer 1
+	Crossbar crossbar;
+	SynapseSwitch synapse_switches;
+	std::array<VerticalRepeater, Coordinate::VRepeaterOnHICANN::size> vertical_repeaters;
+	std::array<HorizontalRepeater, Coordinate::HRepeaterOnHICANN::size> horizontal_repeaters;
+	std::array<RepeaterBlock, Coordinate::RepeaterBlockOnHICANN::size> repeater_blocks;
+
+	// synapses
+	std::array<SynapseDriver, Coordinate::SynapseDriverOnHICANN::size> synapse_drivers;
+	/// one entry per SynapseDriverOnHICANN
+	std::vector<DecoderDoubleRow> decoders;
+	/// one entry per SynapseRowOnHICANN
+	std::vector<WeightRow> weights;
+
+	// neurons
+	std::array<NeuronQuad, Coordinate::QuadOnHICANN::size> denmem_quads;
+	NeuronConfig neuron_config;
+
+	// merger tree and background generators
+	MergerTree merger_tree;
+	DNCMergerLine dnc_mergers;
+	Phase phase;
+	BackgroundGeneratorArray background_generators;
+
+	// floating gates
+	std::array<FGConfig, Coordinate::FGBlockOnHICANN::size> fg_config;
+	FGControl floating_gates;
+
+	bool operator==(HICANNConfig const& other) const;
+	bool operator!=(HICANNConfig const& other) const;
+
+private:
+	friend class boost::serialization::access;
+	template<typename Archiver>
+	void serialize(Archiver& ar, unsigned int const);
+};
+
+
+template<typename Archiver>
+void HICANNConfig::serialize(Archiver& ar, unsigned int const)
+{
+	using boost::serialization::make_nvp;
+	// clang-format off
+	ar & make_nvp("crossbar", crossbar)
+	   & make_nvp("synapse_switches", synapse_switches)
+	   & make_nvp("vertical_repeaters", vertical_repeaters)
+	   & make_nvp("horizontal_repeaters", horizontal_repeaters)
+	   & make_nvp("repeater_blocks", repeater_blocks)
+	   & make_nvp("synapse_drivers", synapse_drivers)
+	   & make_nvp("decoders", decoders)
+	   & make_nvp("weights", weights)
+	   & make_nvp("denmem_quads", denmem_quads)
+	   & make_nvp("neuron_config", neuron_config)
+	   & make_nvp("merger_tree", merger_tree)
+	   & make_nvp("dnc_mergers", dnc_mergers)
+	   & make_nvp("phase", phase)
+	   & make_nvp("background_generators", background_generators)
+	   & make_nvp("fg_config", fg_config)
+	   & make_nvp("floating_gates", floating_gates);
+	// clang-format on
+}
+
+} // HICANN
+} // HMF
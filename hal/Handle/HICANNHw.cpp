@@ -32,5 +32,15 @@ uint8_t HICANNHw::jtag_addr() const
 	return m_jtag_addr;
 }
 
+boost::shared_ptr< ::HMF::HICANN::ShadowState> HICANNHw::shadow_state() const
+{
+	return m_shadow_state;
+}
+
+void HICANNHw::set_shadow_state(boost::shared_ptr< ::HMF::HICANN::ShadowState> const& state)
+{
+	m_shadow_state = state;
+}
+
 }// namespace Handle
 } // namespace HMF
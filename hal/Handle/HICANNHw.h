@@ -1,5 +1,6 @@
 #pragma once
 
+#include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
 
 #include "hal/Handle/HICANN.h"
@@ -11,6 +12,10 @@ namespace facets {
 }
 
 namespace HMF {
+namespace HICANN {
+	class ShadowState;
+}
+
 namespace Handle {
 
 struct FPGAHw;
@@ -30,6 +35,10 @@ struct HICANNHw : public HICANN
 	uint8_t jtag_addr() const;
 	bool isKintex() const;
 
+	/// Opt-in cache of the written configuration, cf. HICANN::ShadowState. Null if disabled.
+	PYPP_EXCLUDE(boost::shared_ptr< ::HMF::HICANN::ShadowState> shadow_state() const;)
+	PYPP_EXCLUDE(void set_shadow_state(boost::shared_ptr< ::HMF::HICANN::ShadowState> const& state);)
+
 	/// Construct a HICANN that is connected to FPGA f
 	HICANNHw(Coordinate::HICANNGlobal const& h,
 	         const boost::shared_ptr<facets::ReticleControl>& rc, uint8_t jtag_addr,
@@ -39,6 +48,7 @@ private:
 	boost::weak_ptr<facets::ReticleControl> mReticleControl;
 	const uint8_t m_jtag_addr;
 	const bool mKintex;
+	boost::shared_ptr< ::HMF::HICANN::ShadowState> m_shadow_state;
 };
 
 } // namespace Handle
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+namespace HMF {
+
+/**
+ * @brief Waiting strategy for polling a resource without notification support.
+ *
+ * Each call to wait_until() waits once: the first calls only yield the
+ * processor, afterwards the thread sleeps with exponentially growing durations
+ * between min_sleep and max_sleep. A wait never extends beyond the given
+ * deadline. reset() should be called whenever polling made progress, so that
+ * the next gap is again detected with low latency.
+ */
+class Backoff
+{
+public:
+	typedef std::chrono::steady_clock clock_type;
+
+	Backoff(
+		size_t const num_yields = 64,
+		std::chrono::nanoseconds const min_sleep = std::chrono::microseconds(1),
+		std::chrono::nanoseconds const max_sleep = std::chrono::milliseconds(1))
+		: m_num_yields(num_yields),
+		  m_min_sleep(min_sleep),
+		  m_max_sleep(std::max(min_sleep, max_sleep)),
+		  m_yields(0),
+		  m_sleep(min_sleep),
+		  m_wakeups(0)
+	{}
+
+	void reset()
+	{
+		m_yields = 0;
+		m_sleep = m_min_sleep;
+	}
+
+	void wait_until(clock_type::time_point const deadline)
+	{
+		++m_wakeups;
+		if (m_yields < m_num_yields) {
+			++m_yields;
+			std::this_thread::yield();
+			return;
+		}
+
+		auto const now = clock_type::now();
+		if (now >= deadline) {
+			return;
+		}
+		std::this_thread::sleep_for(std::min<clock_type::duration>(m_sleep, deadline - now));
+		m_sleep = std::min(2 * m_sleep, m_max_sleep);
+	}
+
+	/// Number of waits since construction.
+	size_t wakeups() const { return m_wakeups; }
+
+private:
+	size_t const m_num_yields;
+	std::chrono::nanoseconds const m_min_sleep;
+	std::chrono::nanoseconds const m_max_sleep;
+
+	size_t m_yields;
+	std::chrono::nanoseconds m_sleep;
+	size_t m_wakeups;
+};
+
+} // namespace HMF
@@ -0,0 +1,160 @@
+#include "hal/backend/BusyWait.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+
+#include "hal/backend/Backoff.h"
+
+namespace HMF {
+namespace HICANN {
+
+namespace {
+
+typedef Backoff::clock_type clock_type;
+
+// A busy wait polls in three phases: num_spins polls back to back, then
+// num_yields polls each after yielding the processor, then polls separated by
+// exponentially growing sleeps of min_sleep up to max_sleep (cf. Backoff).
+size_t const num_spins = 16;
+size_t const num_yields = 16;
+std::chrono::nanoseconds const min_sleep = std::chrono::microseconds(1);
+std::chrono::nanoseconds const max_sleep = std::chrono::milliseconds(1);
+
+struct AtomicCounters
+{
+	std::atomic<size_t> waits;
+	std::atomic<size_t> polls;
+	std::atomic<size_t> timeouts;
+	std::atomic<std::int64_t> wait_time_ns;
+	std::atomic<std::int64_t> timeout_ns;
+};
+
+std::chrono::nanoseconds const default_timeout = std::chrono::seconds(10);
+
+// zero-initialized, a timeout of 0 denotes the default
+std::array<AtomicCounters, num_waiting_controllers> g_counters;
+
+AtomicCounters& counters(WaitingController const controller)
+{
+	return g_counters.at(static_cast<size_t>(controller));
+}
+
+std::string timeout_message(
+	WaitingController const controller, std::chrono::nanoseconds const waited)
+{
+	std::stringstream msg;
+	msg << to_string(controller) << " still busy after "
+	    << std::chrono::duration_cast<std::chrono::milliseconds>(waited).count() << "ms";
+	return msg.str();
+}
+
+} // namespace
+
+char const* to_string(WaitingController const controller)
+{
+	switch (controller) {
+		case WaitingController::synapse_array:
+			return "synapse array";
+		case WaitingController::synapse_driver:
+			return "synapse driver";
+		case WaitingController::floating_gate:
+			return "floating gate controller";
+		case WaitingController::command_queue:
+			return "command queue";
+	}
+	return "unknown controller";
+}
+
+BusyWaitTimeout::BusyWaitTimeout(
+	WaitingController const controller, std::chrono::nanoseconds const waited)
+	: std::runtime_error(timeout_message(controller, waited)),
+	  m_controller(controller),
+	  m_waited(waited)
+{
+}
+
+void set_busy_wait_timeout(
+	WaitingController const controller, std::chrono::nanoseconds const timeout)
+{
+	if (timeout.count() <= 0)
+		throw std::invalid_argument("set_busy_wait_timeout: timeout has to be positive");
+	counters(controller).timeout_ns = timeout.count();
+}
+
+std::chrono::nanoseconds busy_wait_timeout(WaitingController const controller)
+{
+	std::chrono::nanoseconds const timeout(counters(controller).timeout_ns);
+	return timeout.count() > 0 ? timeout : default_timeout;
+}
+
+BusyWaitCounters busy_wait_counters(WaitingController const controller)
+{
+	AtomicCounters const& c = counters(controller);
+	BusyWaitCounters result;
+	result.waits = c.waits;
+	result.polls = c.polls;
+	result.timeouts = c.timeouts;
+	result.wait_time = std::chrono::nanoseconds(c.wait_time_ns);
+	return result;
+}
+
+void reset_busy_wait_counters()
+{
+	for (auto& c : g_counters) {
+		c.waits = 0;
+		c.polls = 0;
+		c.timeouts = 0;
+		c.wait_time_ns = 0;
+	}
+}
+
+void busy_wait(WaitingController const controller, std::function<bool()> const& busy)
+{
+	// fast path: not busy at all
+	if (!busy()) {
+		detail::account_busy_wait(controller, 1, std::chrono::nanoseconds(0), false);
+		return;
+	}
+
+	auto const start = clock_type::now();
+	auto const deadline = start + busy_wait_timeout(controller);
+	Backoff backoff(num_yields, min_sleep, max_sleep);
+
+	for (size_t polls = 2;; ++polls) {
+		bool const still_busy = busy();
+		auto const now = clock_type::now();
+		if (!still_busy) {
+			detail::account_busy_wait(controller, polls, now - start, false);
+			return;
+		}
+		if (now >= deadline) {
+			detail::account_busy_wait(controller, polls, now - start, true);
+			throw BusyWaitTimeout(controller, now - start);
+		}
+		if (polls > num_spins)
+			backoff.wait_until(deadline);
+	}
+}
+
+namespace detail {
+
+void account_busy_wait(
+	WaitingController const controller,
+	size_t const polls,
+	std::chrono::nanoseconds const wait_time,
+	bool const timeout)
+{
+	AtomicCounters& c = counters(controller);
+	++c.waits;
+	c.polls += polls;
+	c.wait_time_ns += wait_time.count();
+	if (timeout)
+		++c.timeouts;
+}
+
+} // namespace detail
+
+} // HICANN
+} // HMF
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+namespace HMF {
+namespace HICANN {
+
+/// Controllers whose busy waits are configured and accounted separately.
+enum class WaitingController : size_t
+{
+	synapse_array,  //!< synapse controller, weight and decoder array access
+	synapse_driver, //!< synapse controller, synapse driver register access
+	floating_gate,  //!< floating gate controller
+	command_queue   //!< blocking commands executed by HICANN::apply()
+};
+
+/// Number of WaitingController values.
+static const size_t num_waiting_controllers = 4;
+
+char const* to_string(WaitingController controller);
+
+/// Thrown if a controller is still busy after the deadline of its busy wait.
+class BusyWaitTimeout : public std::runtime_error
+{
+public:
+	BusyWaitTimeout(WaitingController controller, std::chrono::nanoseconds waited);
+
+	WaitingController controller() const { return m_controller; }
+	std::chrono::nanoseconds waited() const { return m_waited; }
+
+private:
+	WaitingController m_controller;
+	std::chrono::nanoseconds m_waited;
+};
+
+struct BusyWaitCounters
+{
+	BusyWaitCounters() : waits(0), polls(0), timeouts(0), wait_time(0) {}
+
+	size_t waits;
+	/// Number of busy flag reads, including the final one of each wait.
+	size_t polls;
+	size_t timeouts;
+	/// Time from the first busy poll until the controller was not busy anymore.
+	std::chrono::nanoseconds wait_time;
+};
+
+/**
+ * Deadline of a single busy wait on @a controller, 10s by default.
+ *
+ * @note Setting and reading the timeouts and counters is thread-safe.
+ */
+void set_busy_wait_timeout(WaitingController controller, std::chrono::nanoseconds timeout);
+std::chrono::nanoseconds busy_wait_timeout(WaitingController controller);
+
+/// Accumulated counters of all busy waits on @a controller, e.g. over all HICANNs and threads.
+BusyWaitCounters busy_wait_counters(WaitingController controller);
+void reset_busy_wait_counters();
+
+/**
+ * Polls @a busy until it returns false.
+ *
+ * As most busy periods are short, the flag is first polled 16 times back to
+ * back. The next 16 polls each follow a yield of the thread, afterwards it
+ * sleeps between polls for 1us growing up to 1ms (cf. Backoff), so that many
+ * configuration threads can share the cores of a host.
+ *
+ * @throw BusyWaitTimeout If still busy after busy_wait_timeout(controller).
+ */
+void busy_wait(WaitingController controller, std::function<bool()> const& busy);
+
+namespace detail {
+
+/// Accounts a wait performed outside of busy_wait(), cf. HICANN::apply().
+void account_busy_wait(
+	WaitingController controller, size_t polls, std::chrono::nanoseconds wait_time, bool timeout);
+
+} // namespace detail
+
+} // HICANN
+} // HMF
@@ -0,0 +1,196 @@
+#include "hal/backend/CommandScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+#include "hal/HICANN/FGErrorResult.h"
+#include "hal/HICANN/FGInstruction.h"
+#include "hal/backend/Backoff.h"
+#include "hal/backend/BusyWait.h"
+
+#include "synapse_control.h" //synapse control class
+#include "fg_control.h"      //floating gate control
+
+using namespace facets;
+using namespace HMF::Coordinate;
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("halbe.backend.hicann");
+
+namespace HMF {
+namespace HICANN {
+
+CommandSchedulerStatistics apply(std::vector<BlockingCommandQueue> const& queues)
+{
+	typedef Backoff::clock_type clock_type;
+
+	CommandSchedulerStatistics statistics;
+
+	struct Progress
+	{
+		size_t idx;
+		std::function<bool()> const* busy;
+		clock_type::time_point issued;
+		size_t polls;
+	};
+	std::vector<Progress> progress(queues.size(), Progress{0, nullptr, {}, 0});
+
+	auto const timeout = busy_wait_timeout(WaitingController::command_queue);
+	Backoff backoff(16, std::chrono::microseconds(1), std::chrono::milliseconds(1));
+
+	for (bool all_done = false; !all_done;) {
+		all_done = true;
+		bool progressed = false;
+		clock_type::time_point deadline = clock_type::time_point::max();
+		for (size_t i = 0; i < queues.size(); ++i) {
+			auto const& queue = queues[i];
+			Progress& p = progress[i];
+
+			if (p.busy) {
+				all_done = false;
+				++p.polls;
+				bool const busy = (*p.busy)();
+				auto const now = clock_type::now();
+				if (busy) {
+					++statistics.busy_polls;
+					if (now - p.issued >= timeout) {
+						detail::account_busy_wait(
+						    WaitingController::command_queue, p.polls, now - p.issued, true);
+						throw BusyWaitTimeout(WaitingController::command_queue, now - p.issued);
+					}
+					deadline = std::min(deadline, p.issued + timeout);
+					continue;
+				}
+				detail::account_busy_wait(
+				    WaitingController::command_queue, p.polls, now - p.issued, false);
+				p.busy = nullptr;
+			}
+
+			// issue everything up to and including the next blocking or yielding command
+			while (p.idx < queue.size() && !p.busy) {
+				BlockingCommand const& cmd = queue[p.idx++];
+				cmd.issue();
+				progressed = true;
+				++statistics.commands;
+				if (cmd.busy) {
+					++statistics.blocking_commands;
+					p.busy = &cmd.busy;
+					p.issued = clock_type::now();
+					p.polls = 0;
+				} else if (cmd.yield) {
+					break;
+				}
+			}
+			if (p.busy || p.idx < queue.size())
+				all_done = false;
+		}
+
+		// all controllers busy
+		if (progressed)
+			backoff.reset();
+		else if (!all_done)
+			backoff.wait_until(deadline);
+	}
+
+	LOG4CXX_DEBUG(
+		logger, "apply: " << statistics.commands << " commands ("
+		                  << statistics.blocking_commands << " blocking) on " << queues.size()
+		                  << " queues, " << statistics.busy_polls << " busy polls");
+	return statistics;
+}
+
+std::function<bool()> synapse_controller_busy(Handle::HICANNHw& h, unsigned int const index)
+{
+	ReticleControl& reticle = *h.get_reticle();
+	SynapseControl& sc = reticle.hicann[h.jtag_addr()]->getSC(index);
+	return [&sc]() { return sc.arraybusy(); };
+}
+
+std::function<bool()> fg_controller_busy(Handle::HICANNHw& h, FGBlockOnHICANN const& b)
+{
+	return [&h, b]() { return FGErrorResult{fg_read_answer(h, b)}.get_busy_flag(); };
+}
+
+void push_sc_write_data(
+	Handle::HICANNHw& h, sc_write_data_queue_t const& data, BlockingCommandQueue& queue)
+{
+	ReticleControl& reticle = *h.get_reticle();
+	auto& hicann = reticle.hicann[h.jtag_addr()];
+
+	queue.reserve(queue.size() + data.size());
+	for (auto const& instr : data) {
+		SynapseControl& sc = hicann->getSC(instr.index);
+		BlockingCommand cmd;
+		cmd.issue = [&sc, instr]() { sc.write_data(instr.addr, instr.data); };
+		if (instr.type == sc_write_data::WRITEANDWAIT)
+			cmd.busy = [&sc]() { return sc.arraybusy(); };
+		queue.push_back(std::move(cmd));
+	}
+}
+
+void push_synapse_driver(
+	Handle::HICANNHw& h,
+	SynapseDriverOnHICANN const& s,
+	SynapseDriver const& driver,
+	BlockingCommandQueue& queue)
+{
+	ReticleControl& reticle = *h.get_reticle();
+	auto& hicann = reticle.hicann[h.jtag_addr()];
+
+	set_synapse_driver_impl(s, driver, [&hicann, &queue](sc_write_data const& instr) {
+		SynapseControl& sc = hicann->getSC(instr.index);
+		auto const busy = [&sc]() { return sc.driverbusy(); };
+		// the drivers may still be busy from before the queue
+		if (queue.empty())
+			queue.push_back(BlockingCommand{[]() {}, busy});
+		queue.push_back(BlockingCommand{[&sc, instr]() { sc.write_data(instr.addr, instr.data); }, busy});
+	});
+}
+
+void push_fg_values(
+	Handle::HICANNHw& h,
+	FGBlockOnHICANN const& b,
+	FGBlock const& fgb,
+	BlockingCommandQueue& queue)
+{
+	ReticleControl& reticle = *h.get_reticle();
+	facets::FGControl& fc = reticle.hicann[h.jtag_addr()]->getFC(b.id());
+
+	// last answer of the controller, holds the first error flags after a write cycle
+	auto const value = std::make_shared<ci_data_t>(0);
+	auto const busy = [&h, b, value]() {
+		*value = fg_read_answer(h, b);
+		return FGErrorResult{*value}.get_busy_flag();
+	};
+
+	for (size_t row = 0; row < FGBlock::fg_lines; row++) {
+		auto const data = fgb.set_formatter(b, row);
+		BlockingCommand write;
+		write.issue = [&fc, data]() {
+			size_t cnt = 0;
+			for (auto const& val : data)
+				fc.write_data(cnt++, val.to_ulong());
+		};
+		queue.push_back(std::move(write));
+
+		// reads out the error flags, cf. fg_busy_wait()
+		BlockingCommand const log_error{[&h, b, row, value]() { fg_log_error(h, b, row, *value); }, {}};
+
+		// execute write cycle: first write down, then write up
+		queue.push_back(BlockingCommand{
+			[&fc, row]() {
+				fc.write_data(facets::FGControl::REG_ADDRINS, FGInstruction::writeDown(row));
+			},
+			busy});
+		queue.push_back(log_error);
+		queue.push_back(BlockingCommand{
+			[&fc, row]() {
+				fc.write_data(facets::FGControl::REG_ADDRINS, FGInstruction::writeUp(row));
+			},
+			busy});
+		queue.push_back(log_error);
+	}
+}
+
+} // HICANN
+} // HMF
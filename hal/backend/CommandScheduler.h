@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "hal/Coordinate/HMFGeometry.h"
+#include "hal/Handle/HICANNHw.h"
+#include "hal/backend/HICANNBackendHelper.h"
+
+namespace HMF {
+namespace HICANN {
+
+/**
+ * @brief Single access to a HICANN controller.
+ *
+ * After @a issue the controller may stay busy, the next command of the same
+ * queue is not issued before @a busy returned false. Commands without @a busy
+ * (e.g. repeater, L1 switch or neuron builder writes) are not blocking.
+ *
+ * After a command with @a yield the remainder of its queue is issued once all
+ * other queues had their turn. This interleaves long non-blocking queues with
+ * blocking ones, without waiting on any controller.
+ */
+struct BlockingCommand
+{
+	BlockingCommand() : yield(false) {}
+	BlockingCommand(std::function<void()> issue, std::function<bool()> busy = {}) :
+		issue(std::move(issue)), busy(std::move(busy)), yield(false) {}
+
+	static BlockingCommand yielding(std::function<void()> issue)
+	{
+		BlockingCommand cmd(std::move(issue));
+		cmd.yield = true;
+		return cmd;
+	}
+
+	std::function<void()> issue;
+	std::function<bool()> busy;
+	bool yield;
+};
+
+typedef std::vector<BlockingCommand> BlockingCommandQueue;
+
+struct CommandSchedulerStatistics
+{
+	CommandSchedulerStatistics() : commands(0), blocking_commands(0), busy_polls(0) {}
+
+	size_t commands;
+	/// Number of commands with a busy flag, yielding commands are not counted.
+	size_t blocking_commands;
+	/// Number of polls which found a controller still busy.
+	size_t busy_polls;
+};
+
+/**
+ * Executes independent command queues, e.g. one per HICANN of a reticle or
+ * wafer, interleaved.
+ *
+ * Commands of each queue are issued in order. Queues are served round-robin:
+ * If the controller of a queue is still busy, it is polled again after all
+ * other queues had their turn, hence no queue waits on the busy flag of
+ * another one. If all controllers are busy, the thread backs off (cf.
+ * Backoff) instead of spinning.
+ *
+ * @throw BusyWaitTimeout If a controller is busy longer than
+ *        busy_wait_timeout(WaitingController::command_queue) after a command.
+ *
+ * @note Commands of one queue must only block their own controller. Queues
+ *       addressing the same controller have to be merged beforehand.
+ */
+CommandSchedulerStatistics apply(std::vector<BlockingCommandQueue> const& queues);
+
+/** busy flag of a synapse controller, cf. facets::HicannCtrl::Synapse */
+std::function<bool()> synapse_controller_busy(Handle::HICANNHw& h, unsigned int index);
+
+/** busy flag of a floating gate controller */
+std::function<bool()> fg_controller_busy(
+	Handle::HICANNHw& h, Coordinate::FGBlockOnHICANN const& b);
+
+/** appends synapse controller writes, flushes block until the array is not busy */
+void push_sc_write_data(
+	Handle::HICANNHw& h, sc_write_data_queue_t const& data, BlockingCommandQueue& queue);
+
+/**
+ * appends the writes configuring a synapse driver (cf. set_synapse_driver()),
+ * each of them blocks until the drivers of the controller are not busy
+ */
+void push_synapse_driver(
+	Handle::HICANNHw& h,
+	Coordinate::SynapseDriverOnHICANN const& s,
+	SynapseDriver const& driver,
+	BlockingCommandQueue& queue);
+
+/**
+ * appends programming all rows of a floating gate block (cf. set_fg_values()),
+ * writing down and up block until the controller is not busy, afterwards the
+ * error flags are read out and logged (cf. fg_log_error())
+ */
+void push_fg_values(
+	Handle::HICANNHw& h,
+	Coordinate::FGBlockOnHICANN const& b,
+	FGBlock const& fgb,
+	BlockingCommandQueue& queue);
+
+} // HICANN
+} // HMF
@@ -1,16 +1,26 @@
 #include "FPGABackend.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
+#include <exception>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 
 #include <boost/config.hpp>
 
 #include "hal/Coordinate/FormatHelper.h"
 #include "hal/Coordinate/iter_all.h"
+#include "hal/FPGA/PlaybackPulses.h"
+#include "hal/FPGA/TraceReducers.h"
+#include "hal/backend/Backoff.h"
 #include "hal/backend/DNCBackend.h"
 #include "hal/backend/FPGABackendHelper.h"
 #include "hal/backend/HICANNBackendHelper.h"
+#include "hal/backend/PulseTransport.h"
+#include "hal/backend/ShadowState.h"
+#include "hal/backend/TraceDecoder.h"
 #include "hal/backend/dispatch.h"
 #include "sctrltp/ARQStream.h"
 
@@ -53,8 +63,12 @@ HALBE_SETTER_GUARDED(EventSystemStartup,
 	std::bitset<8> hicanns;
 	for (auto dnc : Coordinate::iter_all<HMF::Coordinate::DNCOnFPGA>())
 		for (auto hicann : Coordinate::iter_all<HMF::Coordinate::HICANNOnDNC>())
-			if (f.hicann_active(dnc, hicann))
+			if (f.hicann_active(dnc, hicann)) {
 				hicanns[f.getPowerBackend().hicann_reticle_addr(f.get(dnc, hicann)->coordinate())] = true;
+				// the design reset discards the HICANN configuration
+				if (auto const shadow = f.get(dnc, hicann)->shadow_state())
+					shadow->invalidate();
+			}
 
 	if (r.PLL_frequency != ((r.PLL_frequency / 25) * 25))
 		throw std::runtime_error("only 50, 75, 100, 125, 150, 175, 200, 225, 250Mhz supported");
@@ -395,6 +409,74 @@ HALBE_SETTER_GUARDED(EventSetupL2,
 		bg.rate, bg.seed, bg.first_address, bg.last_address, hc);
 }
 
+namespace {
+
+/**
+ * HostARQ connection of an FPGA handle.
+ *
+ * The HostAL packs the playback frames itself and only accepts single pulses,
+ * it offers no interface to hand over pre-packed frames.
+ */
+class HostALTransport : public PulseTransport
+{
+public:
+	explicit HostALTransport(HostALController& host_al)
+		: m_host_al(host_al), m_arq(host_al.getARQStream())
+	{}
+
+	/// Hands the encoded pulses and the end-of-experiment marker to the HostAL.
+	bool upload_playback(
+		PlaybackPulseEncoder::buffer_type const& pulses,
+		std::uint64_t const end_of_experiment_timestamp) override
+	{
+		for (auto const& pulse : pulses)
+			m_host_al.addPlaybackPulse(pulse.fpga_time, pulse.hicann_time, pulse.label);
+		return flush_playback(end_of_experiment_timestamp);
+	}
+
+	/**
+	 * Hands validated @a events and the end-of-experiment marker to the HostAL,
+	 * without encoding them into an intermediate buffer first.
+	 */
+	bool stream_playback(
+		PulseEventContainer const& events,
+		std::uint16_t const fpga_hicann_delay,
+		std::uint64_t const end_of_experiment_timestamp)
+	{
+		for (auto const& event : events.data())
+			m_host_al.addPlaybackPulse(
+			    PlaybackPulseEncoder::release_time(event.getTime(), fpga_hicann_delay),
+			    event.getTime(), event.getLabel());
+		return flush_playback(end_of_experiment_timestamp);
+	}
+
+	bool receive(sctrltp::packet& packet) override { return m_arq->receive(packet); }
+
+private:
+	bool flush_playback(std::uint64_t const end_of_experiment_timestamp)
+	{
+		// Add end of experiment marker
+		m_host_al.addPlaybackFPGAConfig(
+		    end_of_experiment_timestamp, true /*end_mark*/, true /*stop trace*/,
+		    true /*start trace read*/);
+		return m_host_al.flushPlaybackPulses();
+	}
+
+	HostALController& m_host_al;
+	sctrltp::ARQStream* const m_arq;
+};
+
+void upload_playback_pulses(
+	PulseTransport& transport,
+	PlaybackPulseEncoder::buffer_type const& pulses,
+	uint64_t const end_of_experiment_timestamp)
+{
+	if (!transport.upload_playback(pulses, end_of_experiment_timestamp))
+		throw std::runtime_error("write_playback_pulses: failed to send pulse packets to FPGA");
+}
+
+} // namespace
+
 // TODO: uint16_t is ugly!
 HALBE_SETTER_GUARDED(EventSetupL2,
 	write_playback_pulses,
@@ -403,32 +485,33 @@ HALBE_SETTER_GUARDED(EventSetupL2,
 	PulseEvent::spiketime_t, runtime,
 	uint16_t,fpga_hicann_delay)
 {
-	HostALController& host_al = f.getPowerBackend().get_host_al(f);
+	// validate all pulses before anything is sent to the FPGA
+	std::uint64_t const end_of_experiment_timestamp =
+		PlaybackPulseEncoder::validate(st, runtime, fpga_hicann_delay);
 
-	size_t const npulses = st.size();
-	uint64_t last_fpga_time = 0;
-	for (size_t n = 0; n < npulses; ++n) {
-		PulseEvent pe = st[n];
-		if (pe.getTime() < fpga_hicann_delay*2)
-			throw std::runtime_error(
-				"write_playback_pulses: the time of the PulseEvent in the spike "
-				"list has to be greater or equal than fpga_hicann_delay*2");
-		last_fpga_time = pe.getTime()/2 - fpga_hicann_delay;
-		uint16_t id =  pe.getLabel();
-		host_al.addPlaybackPulse(last_fpga_time, /*uint16_t hicann_time*/ pe.getTime(), id);
-	}
+	HostALTransport transport(f.getPowerBackend().get_host_al(f));
+	if (!transport.stream_playback(st, fpga_hicann_delay, end_of_experiment_timestamp))
+		throw std::runtime_error("write_playback_pulses: failed to send pulse packets to FPGA");
+}
 
-	// Calculate EoE timestamp in FPGA clock cycles, devide by two as DNC frequency == 2 * FPGA frequency
-	size_t end_of_experiment_timestamp = (runtime + 1) / 2;
-	if (end_of_experiment_timestamp < last_fpga_time)
-		throw std::runtime_error("write_playback_pulses: runtime shorter than spike trains length");
+HALBE_SETTER_GUARDED(EventSetupL2,
+	write_playback_program,
+	Handle::FPGA &, f,
+	PlaybackProgram const&, program)
+{
+	HostALTransport transport(f.getPowerBackend().get_host_al(f));
+	upload_playback_pulses(transport, program.pulses(), program.end_of_experiment_timestamp());
+}
 
-	// Add end of experiment marker
-	host_al.addPlaybackFPGAConfig(
-	    end_of_experiment_timestamp, true /*end_mark*/, true /*stop trace*/, true /*start trace read*/);
-	bool success = host_al.flushPlaybackPulses();
-	if (!success)
-		throw std::runtime_error("write_playback_pulses: failed to send pulse packets to FPGA");
+void write_playback_pulses(
+	PulseTransport& transport,
+	PulseEventContainer const& st,
+	PulseEvent::spiketime_t const runtime,
+	uint16_t const fpga_hicann_delay)
+{
+	PlaybackPulseEncoder encoder;
+	encoder.encode(st, runtime, fpga_hicann_delay);
+	upload_playback_pulses(transport, encoder.pulses(), encoder.end_of_experiment_timestamp());
 }
 
 // FIXME: Adapt scheriff to upcoming canonical state machine from spec
@@ -440,232 +523,64 @@ HALBE_GETTER(bool, get_pbmem_buffering_completed,
 	return (host_al.getPlaybackEndAddress() != 0);
 }
 
-HALBE_GETTER(AlmostSortedPulseEvents, read_trace_pulses,
-	Handle::FPGA &, f,
-	PulseEvent::spiketime_t const, runtime,
-	bool const, drop_background_events
-	)
+namespace {
+
+/**
+ * Receives and decodes trace pulse events until the end-of-trace marker arrives.
+ *
+ * The decoded (and not dropped) pulse events of each packet are passed to
+ * @a output in the (almost sorted) order of arrival.
+ *
+ * @return Number of dropped events.
+ */
+template <typename Output>
+size_t receive_trace_pulses(
+	Coordinate::FPGAGlobal const& fpga,
+	PulseTransport& transport,
+	PulseEvent::spiketime_t const runtime,
+	TraceEventFilter const& filter,
+	Output& output)
 {
-	// We have to handle all possible types of packets described in section
-	// "I-10.2.1. FPGA Trace / Pulse Data" of the specification, i.e. pulse
-	// entries and overflow indicators.
-
-	// Each 64 bit packet consists of two entries aligned to 32 bit.
+	TraceDecoder decoder(fpga, filter);
+	size_t stored_events = 0;
 
-	constexpr size_t EVENT_TIMESTAMP_BITS = 15;
-	union entry_type
-	{
-		std::uint32_t raw;
-		// A pulse event is indicated by two '0' high-order bits.  The sequence '01'
-		// is used to mark the absence of a pulse event in a packet that contains an
-		// overflow indicator.
-		struct
-		{
-			// LSBs of pulse event timestamp, MSBs are transmitted via overflow indicators.
-			unsigned int timestamp : EVENT_TIMESTAMP_BITS;
-			// Label of pulse event, as described below.
-			unsigned int label : 12;
-			unsigned int : 2; // padding
-			// MSB of the FPGA systime counter.
-			unsigned int fpga_msb : 1;
-			// Two zero-bits, to encode entry type.
-			unsigned int zero_bits : 2;
-		} event;
-		// An overflow indicator is indicated by a '1' high-order bit.
-		struct
-		{
-			unsigned int count : 31;
-			unsigned int is_overflow : 1;
-		} overflow;
-	};
-
-	// A pulse event label consists of 12 bit used as follows:
-	// |     3bit    |   3bit   |    6bit   |
-	// | HICANNOnDNC | GbitLink | L1Address |
-	// Each pulse label will be converted to a 16 bit PulseAddress,
-	// where the additional 4 bit remain unused.
-
-	// Count the number of overflow indicators to calculate MSBs of full time stamp.
-	std::uint64_t trace_overflow_count = 0;
-	constexpr std::uint64_t MAX_TIMESTAMP_CNT = 1 << EVENT_TIMESTAMP_BITS;
-
-	bool const trace_enabled = logger->isTraceEnabled();
-#define HALBE_RTP_TRACE(message) \
-	{ \
-		if (LOG4CXX_UNLIKELY(trace_enabled)) { \
-			::log4cxx::helpers::MessageBuffer oss_; \
-			logger->forcedLog( \
-			    ::log4cxx::Level::getTrace(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
-		} \
-	}
-
-	size_t dropped_events = 0;
-	AlmostSortedPulseEvents::container_type pulse_events;
 	auto const receive_pulse_events =
-		[trace_enabled, drop_background_events, &dropped_events, &pulse_events,
-		 &trace_overflow_count,
-		 &f](sctrltp::ARQStream* const arq_ptr) -> std::tuple<bool, std::uint64_t> {
+		[&decoder, &stored_events, &output, &fpga,
+		 &transport]() -> std::tuple<bool, std::uint64_t> {
 
 		bool received_eot = false;
 		std::uint64_t received_pulse_events_count = 0;
 		// FIXME@ECM: defined in hicann-system/…/ARQFrame.h (no namespace)
 		sctrltp::packet current_packet;
-		while ((!received_eot) && arq_ptr->receive(current_packet)) {
-			HALBE_RTP_TRACE("received hostARQ packet with " << current_packet.len << " entries");
+		while ((!received_eot) && transport.receive(current_packet)) {
+			LOG4CXX_TRACE(logger, "received hostARQ packet with " << current_packet.len << " entries");
 			if (BOOST_UNLIKELY(current_packet.pid !=
 			                   application_layer_packet_types::FPGATRACE)) {
 				LOG4CXX_ERROR(logger,
-				              HMF::Coordinate::short_format(f.coordinate())
+				              HMF::Coordinate::short_format(fpga)
 				                  << " unexpected frame type in read_trace_pulses: "
 				                  << current_packet.pid);
 				throw std::runtime_error("unexpected frame type in read_trace_pulses");
 			}
 
-			entry_type* const entries = reinterpret_cast<entry_type*>(current_packet.pdu);
-
-			for (std::uint16_t ii = 0; ii < 2 * current_packet.len; ++ii) {
-
-				// check for end-of-trace marker every 64-bit word
-				if ((ii % 2) == 0) {
-					if (current_packet.pdu[ii/2] == 0x4000E11D40000000ull) {
-						if (((ii/2) + 1) < current_packet.len) {
-							std::stringstream debug_msg;
-							debug_msg << HMF::Coordinate::short_format(f.coordinate())
-							          << " unexpected end-of-trace marker"
-							             " within other data: " << ii / 2 << " out of "
-							          << (current_packet.len - 1) << ".\n"
-							          << " Next entry looks like: " << std::hex
-							          << current_packet.pdu[(ii / 2) + 1] << std::dec
-							          << "\n";
-							LOG4CXX_ERROR(logger, debug_msg.str());
-							// FIXME: we should throw std::runtime_error(debug_msg.str()); here
-						}
-						// packet handling done, bail out
-						received_eot = true;
-						break;
-					}
-				}
-
-				// non-eot data handling below
-				auto const& entry = entries[ii];
-
-				if (entry.overflow.is_overflow) {
-					if (BOOST_UNLIKELY(ii % 2 != 1)) {
-#ifndef NDEBUG
-						// Overflow entries should only occur at odd indices.
-						LOG4CXX_WARN(logger,
-						             HMF::Coordinate::short_format(f.coordinate())
-						                 << " garbage overflow entry at even index " << ii
-						                 << ": " << std::showbase << std::hex << entry.raw
-						                 << " (issue 2355)");
-#endif // !NDEBUG
-						continue;
-					}
-					trace_overflow_count += 1;
-
-#ifndef NDEBUG
-					HALBE_RTP_TRACE(
-						"overflow packet " << trace_overflow_count
-						<< std::showbase
-						<< " with value " << std::hex << entry.overflow.count
-						<< " (" << std::dec << entry.overflow.count << ")" << " received.\n"
-						<< " current offset is " << std::hex << trace_overflow_count * MAX_TIMESTAMP_CNT
-						<< " (" << std::dec << trace_overflow_count * MAX_TIMESTAMP_CNT << ")");
-
-					if (trace_overflow_count != entry.overflow.count) {
-						LOG4CXX_WARN(
-						    logger,
-						    HMF::Coordinate::short_format(f.coordinate())
-						        << " Local overflow count " << trace_overflow_count
-						        << " does not match contents of overflow indicator "
-						        << entry.overflow.count);
-					}
-#endif // !NDEBUG
-
-					continue;
-				} else if (entry.event.zero_bits != 0) {
-					// no overflow, no spike => garbage
-					continue;
-				}
-
-				std::uint64_t full_timestamp =
-					static_cast<std::uint64_t>(entry.event.timestamp) +
-					trace_overflow_count * MAX_TIMESTAMP_CNT;
-				bool timestamp_msb = entry.event.timestamp >> (EVENT_TIMESTAMP_BITS - 1);
-
-				// Detect special case that HICANN timestamp was registered before
-				// overflow, but pulse arrives in FPGA after overflow and an overflow
-				// packet was generated.
-				if (timestamp_msb && !entry.event.fpga_msb) {
-					if (full_timestamp < MAX_TIMESTAMP_CNT) {
-						// Ignore early pulses.
-						continue;
-					}
-					// Undo last overflow for that pulse.
-					full_timestamp -= MAX_TIMESTAMP_CNT;
-				}
-
-#ifndef NDEBUG
-				HALBE_RTP_TRACE(
-					"received pulse event " << received_pulse_events_count << " (entry " << ii << "):\n"
-					<< std::showbase
-					<< "id: " << std::hex << entry.event.label << ", "
-					<< "timestamp: " << std::hex << entry.event.timestamp
-					<< " (" << std::dec << entry.event.timestamp << ")" << ", "
-					<< "msb timestamp/fpga: " << timestamp_msb << "/" << entry.event.fpga_msb << ",\n"
-					<< "full timestamp: " << std::hex << full_timestamp
-					<< " (" << std::dec << full_timestamp << ")");
-
-				if (!pulse_events.empty()) {
-					auto const& last_event = pulse_events.back();
-
-					// Old bug where trace memory potentially stored pulse twice while
-					// sending overflow packet, should not occur anymore.
-					// TODO 2016-04-27: Remove check when it's absolutely sure that the bug is
-					// fixed.
-					if (last_event.getLabel() == entry.event.label &&
-					    (last_event.getTime() == full_timestamp ||
-					     (last_event.getTime() + MAX_TIMESTAMP_CNT) == full_timestamp)) {
-						LOG4CXX_WARN(logger,
-						             HMF::Coordinate::short_format(f.coordinate())
-						                 << " received pulse twice (issue 2022): "
-						                 << pulse_events.back().getTime()
-						                 << " == " << full_timestamp << "\n(32 bit entry "
-						                 << ii << "/" << (2 * current_packet.len)
-						                 << " of ARQ frame, spike " << pulse_events.size()
-						                 << ") with label " << entry.event.label);
-					}
-				}
-#endif // !NDEBUG
+			received_eot = decoder.decode(current_packet.pdu, current_packet.len);
 
-				// Update the count of received pulse events unconditionally, as it is
-				// used to decide when to timeout below.
-				++received_pulse_events_count;
+			// Update the count of received pulse events unconditionally (i.e. including
+			// dropped events), as it is used to decide when to timeout below.
+			received_pulse_events_count += decoder.received_events();
 
-				if (drop_background_events && !(entry.event.label & HICANN::L1Address::max)) {
-					++dropped_events;
-					continue;
-				}
-
-				pulse_events.push_back(
-					PulseEvent(PulseAddress(entry.event.label), full_timestamp));
-			}
+			if (!decoder.events().empty())
+				output(decoder.events());
+			stored_events += decoder.events().size();
 		}
 		return std::make_tuple(received_eot, received_pulse_events_count);
 	}; // receive_pulse_events
 
-#undef HALBE_RTP_TRACE
-
-	if (drop_background_events) {
-		LOG4CXX_INFO(logger, HMF::Coordinate::short_format(f.coordinate())
-		                         << " background pulse events will be dropped");
+	if (!filter.accepts_all()) {
+		LOG4CXX_INFO(logger, HMF::Coordinate::short_format(fpga)
+		                         << " filtered pulse events will be dropped");
 	}
 
-	HostALController& host_al = f.getPowerBackend().get_host_al(f);
-	unsigned int sleep_duration_in_us = 500;
-
-	sctrltp::ARQStream* const arq_ptr = host_al.getARQStream();
-
 	/* We read(receive) data until we see the end-of-trace marker packet.
 	 * However, as the connection might die at any time ("cable being pulled", whatever)
 	 * we cannot just block here but rather have a relaxed timeout as it will only
@@ -686,18 +601,29 @@ HALBE_GETTER(AlmostSortedPulseEvents, read_trace_pulses,
 	static constexpr std::chrono::milliseconds default_timeout{10000};
 
 	// set initial timeout
-	std::chrono::milliseconds const initial_timeout = std::chrono::duration_cast<std::chrono::milliseconds>(default_timeout +
-		std::chrono::microseconds{runtime / DNC_frequency_in_MHz});
+	std::chrono::microseconds const experiment_duration{runtime / DNC_frequency_in_MHz};
+	std::chrono::milliseconds const initial_timeout =
+		std::chrono::duration_cast<std::chrono::milliseconds>(default_timeout + experiment_duration);
 	std::chrono::milliseconds timeout = initial_timeout;
 
+	/* The ARQ stream can only be polled. While the experiment is still running,
+	 * pulse events arrive in bulk and are drained in coarse intervals. Afterwards
+	 * (and after each received packet) we poll with an exponential backoff,
+	 * starting with yields only, to detect newly available data (in particular the
+	 * end-of-trace marker) with low latency without spinning through long gaps.
+	 */
+	static constexpr std::chrono::milliseconds coarse_poll_interval{1};
+	Backoff backoff;
+
 	auto time_of_last_packet = std::chrono::steady_clock::now();
+	auto const expected_end = time_of_last_packet + experiment_duration;
 	auto now = time_of_last_packet;
 	bool received_eot = false;
 	while (!received_eot) {
 		now = std::chrono::steady_clock::now();
 		if ((now - time_of_last_packet) > timeout) {
 			std::stringstream debug_msg;
-			debug_msg << HMF::Coordinate::short_format(f.coordinate())
+			debug_msg << HMF::Coordinate::short_format(fpga)
 			          << ": No end-of-trace marker received in "
 			          << std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count() << "ms.";
 			LOG4CXX_ERROR(logger, debug_msg.str());
@@ -705,32 +631,293 @@ HALBE_GETTER(AlmostSortedPulseEvents, read_trace_pulses,
 		}
 
 		std::uint64_t num_pulses;
-		std::tie(received_eot, num_pulses) = receive_pulse_events(arq_ptr);
+		std::tie(received_eot, num_pulses) = receive_pulse_events();
 		if (num_pulses > 0) {
 			// initial timeout done, now set to default timeout
 			timeout  = default_timeout;
 
 			LOG4CXX_TRACE(logger,
-			              HMF::Coordinate::short_format(f.coordinate())
+			              HMF::Coordinate::short_format(fpga)
 			                  << " received " << num_pulses
 			                  << " pulse events after waiting for "
 			                  << std::chrono::duration_cast<std::chrono::milliseconds>(
 			                         now - time_of_last_packet).count() << " ms");
 			time_of_last_packet = now;
+			backoff.reset();
 			continue;
 		}
 
-		if ((usleep(sleep_duration_in_us) != 0) && (errno != EINTR)) {
-			throw std::runtime_error("usleep failed in read_trace_pulses");
+		if (now + coarse_poll_interval < expected_end) {
+			std::this_thread::sleep_for(coarse_poll_interval);
+			continue;
 		}
+		backoff.wait_until(time_of_last_packet + timeout);
 	}
-	LOG4CXX_INFO(logger, HMF::Coordinate::short_format(f.coordinate())
-	                         << " received " << (dropped_events + pulse_events.size())
+	LOG4CXX_INFO(logger, HMF::Coordinate::short_format(fpga)
+	                         << " received " << (decoder.dropped_events() + stored_events)
 	                         << " pulse events");
 
+	return decoder.dropped_events();
+}
+
+template <typename Output>
+size_t receive_trace_pulses(
+	Handle::FPGAHw& f,
+	PulseEvent::spiketime_t const runtime,
+	TraceEventFilter const& filter,
+	Output& output)
+{
+	HostALTransport transport(f.getPowerBackend().get_host_al(f));
+	return receive_trace_pulses(f.coordinate(), transport, runtime, filter, output);
+}
+
+/// Collects trace pulse events and hands them on in chunks of bounded size.
+class TracePulseChunker
+{
+public:
+	TracePulseChunker(TracePulseSink const& sink, size_t const chunk_size)
+		: m_sink(sink), m_chunk_size(chunk_size), m_chunk()
+	{
+		m_chunk.reserve(m_chunk_size);
+	}
+
+	void operator()(AlmostSortedPulseEvents::container_type const& events)
+	{
+		for (auto const& event : events) {
+			m_chunk.push_back(event);
+			if (m_chunk.size() >= m_chunk_size)
+				flush();
+		}
+	}
+
+	void flush()
+	{
+		if (m_chunk.empty())
+			return;
+		m_sink(m_chunk);
+		m_chunk.clear();
+	}
+
+private:
+	TracePulseSink const& m_sink;
+	size_t const m_chunk_size;
+	AlmostSortedPulseEvents::container_type m_chunk;
+};
+
+} // namespace
+
+HALBE_GETTER(AlmostSortedPulseEvents, read_trace_pulses,
+	Handle::FPGA &, f,
+	PulseEvent::spiketime_t const, runtime,
+	bool const, drop_background_events
+	)
+{
+	AlmostSortedPulseEvents::container_type pulse_events;
+	auto collect = [&pulse_events](AlmostSortedPulseEvents::container_type const& events) {
+		pulse_events.insert(pulse_events.end(), events.begin(), events.end());
+	};
+	size_t const dropped_events =
+		receive_trace_pulses(f, runtime, background_filter(drop_background_events), collect);
+	return AlmostSortedPulseEvents(std::move(pulse_events), dropped_events);
+}
+
+HALBE_GETTER(AlmostSortedPulseEvents, read_trace_pulses,
+	Handle::FPGA &, f,
+	PulseEvent::spiketime_t const, runtime,
+	TraceEventFilter const&, filter
+	)
+{
+	AlmostSortedPulseEvents::container_type pulse_events;
+	auto collect = [&pulse_events](AlmostSortedPulseEvents::container_type const& events) {
+		pulse_events.insert(pulse_events.end(), events.begin(), events.end());
+	};
+	size_t const dropped_events = receive_trace_pulses(f, runtime, filter, collect);
 	return AlmostSortedPulseEvents(std::move(pulse_events), dropped_events);
 }
 
+AlmostSortedPulseEvents read_trace_pulses(
+	PulseTransport& transport,
+	Coordinate::FPGAGlobal const& fpga,
+	PulseEvent::spiketime_t const runtime,
+	TraceEventFilter const& filter)
+{
+	AlmostSortedPulseEvents::container_type pulse_events;
+	auto collect = [&pulse_events](AlmostSortedPulseEvents::container_type const& events) {
+		pulse_events.insert(pulse_events.end(), events.begin(), events.end());
+	};
+	size_t const dropped_events = receive_trace_pulses(fpga, transport, runtime, filter, collect);
+	return AlmostSortedPulseEvents(std::move(pulse_events), dropped_events);
+}
+
+size_t stream_trace_pulses(
+	Handle::FPGA& f,
+	PulseEvent::spiketime_t const runtime,
+	TracePulseSink const& sink,
+	size_t const chunk_size,
+	bool const drop_background_events)
+{
+	if (chunk_size == 0)
+		throw std::invalid_argument("stream_trace_pulses: chunk size has to be non-zero");
+	if (!sink)
+		throw std::invalid_argument("stream_trace_pulses: no sink given");
+
+	TracePulseChunker chunker(sink, chunk_size);
+	TraceEventFilter const filter = background_filter(drop_background_events);
+	size_t dropped_events = 0;
+	if (auto* const fpga_hw = dynamic_cast<Handle::FPGAHw*>(&f)) {
+		dropped_events = receive_trace_pulses(*fpga_hw, runtime, filter, chunker);
+	} else {
+		// ESS and dumping only provide the trace as a whole, it is handed on in chunks
+		AlmostSortedPulseEvents const pulses = read_trace_pulses(f, runtime, filter);
+		chunker(pulses.events);
+		dropped_events = pulses.dropped_events;
+	}
+	chunker.flush();
+	return dropped_events;
+}
+
+size_t reduce_trace_pulses(
+	Handle::FPGA& f,
+	PulseEvent::spiketime_t const runtime,
+	std::vector<TracePulseReducer*> const& reducers,
+	bool const drop_background_events)
+{
+	if (std::find(reducers.begin(), reducers.end(), nullptr) != reducers.end())
+		throw std::invalid_argument("reduce_trace_pulses: invalid reducer given");
+
+	auto reduce = [&reducers](AlmostSortedPulseEvents::container_type const& events) {
+		for (auto* const reducer : reducers)
+			reducer->reduce(events);
+	};
+	TraceEventFilter const filter = background_filter(drop_background_events);
+	if (auto* const fpga_hw = dynamic_cast<Handle::FPGAHw*>(&f))
+		return receive_trace_pulses(*fpga_hw, runtime, filter, reduce);
+
+	// ESS and dumping only provide the trace as a whole, it is reduced at once
+	AlmostSortedPulseEvents const pulses = read_trace_pulses(f, runtime, filter);
+	reduce(pulses.events);
+	return pulses.dropped_events;
+}
+
+namespace {
+
+/**
+ * K-way merges the sorted pulse events of all FPGAs into @a result, keeping
+ * track of the FPGA each event originates from.
+ */
+void merge_fpga_pulses(
+	std::vector<PulseEventContainer> const& sorted, MultiFPGATracePulses& result)
+{
+	typedef PulseEventContainer::container_type::const_iterator iterator;
+	struct Range
+	{
+		iterator begin;
+		iterator end;
+		size_t fpga;
+	};
+
+	std::vector<Range> heap;
+	size_t total = 0;
+	for (size_t i = 0; i < sorted.size(); ++i) {
+		total += sorted[i].size();
+		if (sorted[i].size() > 0)
+			heap.push_back(Range{sorted[i].data().begin(), sorted[i].data().end(), i});
+	}
+
+	PulseEventContainer::container_type events;
+	events.reserve(total);
+	result.merged_fpga.clear();
+	result.merged_fpga.reserve(total);
+
+	auto const later = [](Range const& a, Range const& b) { return *b.begin < *a.begin; };
+	std::make_heap(heap.begin(), heap.end(), later);
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), later);
+		Range& range = heap.back();
+		events.push_back(*range.begin);
+		result.merged_fpga.push_back(range.fpga);
+		if (++range.begin == range.end) {
+			heap.pop_back();
+		} else {
+			std::push_heap(heap.begin(), heap.end(), later);
+		}
+	}
+
+	// already sorted, hence not reordered
+	result.merged = PulseEventContainer(std::move(events), true);
+}
+
+} // namespace
+
+MultiFPGATracePulses read_trace_pulses(
+	std::vector<boost::shared_ptr<Handle::FPGA> > const& handles,
+	PulseEvent::spiketime_t const runtime,
+	bool const drop_background_events,
+	bool const merge)
+{
+	size_t const n_fpgas = handles.size();
+
+	MultiFPGATracePulses result;
+	result.per_fpga.resize(n_fpgas);
+	std::vector<PulseEventContainer> sorted(merge ? n_fpgas : 0);
+	std::vector<std::exception_ptr> errors(n_fpgas);
+	TraceEventFilter const filter = background_filter(drop_background_events);
+
+	// the pulse events are moved into the sorted buffer, so that each FPGA's
+	// trace is only held once until merged
+	auto finish = [&](size_t const i) {
+		if (merge) {
+			auto& pulses = result.per_fpga[i];
+			sorted[i] = PulseEventContainer(std::move(pulses.events), true);
+			pulses.events.clear();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(n_fpgas);
+	for (size_t i = 0; i < n_fpgas; ++i) {
+		auto* const fpga_hw = dynamic_cast<Handle::FPGAHw*>(handles[i].get());
+		if (!fpga_hw)
+			continue;
+		workers.emplace_back([&, i, fpga_hw]() {
+			try {
+				auto& pulses = result.per_fpga[i];
+				auto collect = [&pulses](AlmostSortedPulseEvents::container_type const& events) {
+					pulses.events.insert(pulses.events.end(), events.begin(), events.end());
+				};
+				pulses.dropped_events = receive_trace_pulses(*fpga_hw, runtime, filter, collect);
+				finish(i);
+			} catch (...) {
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+
+	// other handles (ESS, dumping) are read one after another via the dispatch
+	for (size_t i = 0; i < n_fpgas; ++i) {
+		if (dynamic_cast<Handle::FPGAHw*>(handles[i].get()))
+			continue;
+		try {
+			result.per_fpga[i] = read_trace_pulses(*handles[i], runtime, filter);
+			finish(i);
+		} catch (...) {
+			errors[i] = std::current_exception();
+		}
+	}
+
+	for (auto& worker : workers)
+		worker.join();
+
+	for (auto const& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	if (merge)
+		merge_fpga_pulses(sorted, result);
+	return result;
+}
+
 
 HALBE_SETTER_GUARDED(EventStartExperiment,
 	set_spinnaker_receive_port,
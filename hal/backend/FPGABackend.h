@@ -1,9 +1,14 @@
 #pragma once
 
+#include <functional>
 #include <vector>
 
+#include <boost/shared_ptr.hpp>
+
 #include "hal/Coordinate/HMFGeometry.h"
 #include "hal/FPGAContainer.h"
+#include "hal/FPGA/PlaybackProgram.h"
+#include "hal/FPGA/TraceEventFilter.h"
 //#include "hal/FPGA.h"
 
 #include "RealtimeSpike.h"
@@ -130,6 +135,18 @@ void write_playback_pulses(
 	uint16_t fpga_hicann_delay = 40
 	);
 
+/**
+ * Writes a precompiled playback program into the FPGA playback memory (DDR2).
+ *
+ * Equivalent to write_playback_pulses() with the pulse list, runtime and
+ * delay the program was compiled from, but without validating and encoding
+ * the pulses again. The same program can be written repeatedly.
+ */
+void write_playback_program(
+	Handle::FPGA & f,
+	PlaybackProgram const& program
+	);
+
 /**
  * Check if end-of-experiment FPGA config packet was acknowledged by FPGA
  * (which indicates that buffering has completed).
@@ -150,6 +167,155 @@ AlmostSortedPulseEvents read_trace_pulses(
 	bool drop_background_events = false
 	);
 
+/**
+ * @brief Read pulses from the FPGA trace memory (DDR2), keeping only those
+ *        accepted by @a filter.
+ *
+ * The filter is evaluated while decoding, rejected pulse events are never
+ * stored and reported as dropped events.
+ */
+AlmostSortedPulseEvents read_trace_pulses(
+	Handle::FPGA & f,
+	PulseEvent::spiketime_t runtime,
+	TraceEventFilter const& filter
+	);
+
+#ifndef PYPLUSPLUS
+/**
+ * Receives a chunk of pulse events during a streaming trace readout.
+ *
+ * The chunk is only valid during the call, i.e. the sink has to copy (or reduce)
+ * the events it wants to keep.
+ */
+typedef std::function<void(AlmostSortedPulseEvents::container_type const&)> TracePulseSink;
+
+/**
+ * @brief Read pulses from the FPGA trace memory (DDR2) and hand them on in chunks.
+ *
+ * Streaming variant of read_trace_pulses(): while the transfer is running, every
+ * time @a chunk_size pulse events have been decoded they are passed to @a sink.
+ * The last (possibly smaller) chunk is passed on after the end-of-trace marker
+ * has been received. Timeouts and the reconstruction of full timestamps from
+ * overflow indicators are identical to read_trace_pulses(); the concatenation
+ * of all chunks equals AlmostSortedPulseEvents::events of the latter.
+ * For non-hardware handles (ESS, dumping) the trace is read via the dispatched
+ * read_trace_pulses() and handed on in chunks afterwards.
+ *
+ * @param sink       Callback receiving the chunks in order of arrival.
+ * @param chunk_size Maximum number of pulse events per chunk (has to be non-zero).
+ * @return Number of dropped pulse events.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+size_t stream_trace_pulses(
+	Handle::FPGA & f,
+	PulseEvent::spiketime_t runtime,
+	TracePulseSink const& sink,
+	size_t chunk_size = 1 << 16,
+	bool drop_background_events = false
+	);
+
+class TracePulseReducer;
+
+/**
+ * @brief Read pulses from the FPGA trace memory (DDR2) and only aggregate them.
+ *
+ * The events of each received packet are handed to all @a reducers right after
+ * decoding (see TracePulseReducer), they are not stored. Timeouts and the
+ * reconstruction of full timestamps are identical to read_trace_pulses().
+ * For non-hardware handles (ESS, dumping) the reducers are applied to the
+ * result of the dispatched read_trace_pulses().
+ *
+ * @return Number of dropped pulse events.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+size_t reduce_trace_pulses(
+	Handle::FPGA & f,
+	PulseEvent::spiketime_t runtime,
+	std::vector<TracePulseReducer*> const& reducers,
+	bool drop_background_events = false
+	);
+
+class PulseTransport;
+
+/**
+ * @brief Encode and send pulses to the playback memory via @a transport.
+ *
+ * Equivalent to write_playback_pulses() of a handle, which uses its HostARQ
+ * connection. With a LoopbackTransport the pulse data path can be run and
+ * profiled without hardware.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+void write_playback_pulses(
+	PulseTransport & transport,
+	PulseEventContainer const& st,
+	PulseEvent::spiketime_t runtime,
+	uint16_t fpga_hicann_delay = 40
+	);
+
+/**
+ * @brief Read pulses from the trace memory via @a transport, cf. read_trace_pulses().
+ *
+ * @param fpga Coordinate of the FPGA, only used for logging.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+AlmostSortedPulseEvents read_trace_pulses(
+	PulseTransport & transport,
+	Coordinate::FPGAGlobal const& fpga,
+	PulseEvent::spiketime_t runtime,
+	TraceEventFilter const& filter
+	);
+
+/**
+ * Result of the concurrent trace readout of several FPGAs.
+ */
+struct MultiFPGATracePulses
+{
+	/**
+	 * Pulse events of each FPGA, in the order of the handles.
+	 * @note If merged, the pulse events are only contained in merged and
+	 *       only the number of dropped events is kept per FPGA.
+	 */
+	std::vector<AlmostSortedPulseEvents> per_fpga;
+
+	/**
+	 * Pulse events of all FPGAs sorted by time, only filled if requested.
+	 * @note Pulse addresses are only unique per FPGA, cf. merged_fpga.
+	 */
+	PulseEventContainer merged;
+
+	/// Index of the handle each event of merged was read from.
+	std::vector<size_t> merged_fpga;
+};
+
+/**
+ * @brief Read pulses from the trace memories of several FPGAs concurrently.
+ *
+ * Each hardware FPGA is drained by its own worker thread (cf.
+ * read_trace_pulses() for the parameters), so that the readout time is
+ * determined by the slowest FPGA. Other handles are read one after another
+ * via the dispatched read_trace_pulses() meanwhile.
+ * If @a merge is set, the pulse events of each FPGA are sorted in place and
+ * all of them are k-way merged into a single time-sorted container, along
+ * with the FPGA of each event. The per-FPGA pulse events are released
+ * afterwards, so that the trace is not held twice by the result.
+ *
+ * @throw std::runtime_error If the readout of an FPGA fails, after all
+ *        FPGAs have been read.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+MultiFPGATracePulses read_trace_pulses(
+	std::vector<boost::shared_ptr<Handle::FPGA> > const& handles,
+	PulseEvent::spiketime_t runtime,
+	bool drop_background_events = false,
+	bool merge = false
+	);
+#endif // !PYPLUSPLUS
+
 /**
 *  Set port that the SpiNNaker pulse interface reacts on.
 */
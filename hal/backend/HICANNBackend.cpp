@@ -10,6 +10,9 @@
 
 // handles 
 #include "hal/backend/dispatch.h"
+#include "hal/backend/BusyWait.h"
+#include "hal/backend/CommandScheduler.h"
+#include "hal/backend/ShadowState.h"
 
 // runtime
 #include "hal/Handle/HMFRun.h"
@@ -37,6 +40,73 @@ static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("halbe.backend.hic
 namespace HMF {
 namespace HICANN {
 
+namespace {
+
+void wait_array_idle(SynapseControl& sc)
+{
+	busy_wait(WaitingController::synapse_array, [&sc]() { return sc.arraybusy(); });
+}
+
+void wait_driver_idle(SynapseControl& sc)
+{
+	busy_wait(WaitingController::synapse_driver, [&sc]() { return sc.driverbusy(); });
+}
+
+/**
+ * Hardware handle of @a h for accessing it directly instead of via the
+ * dispatch, null for other backends and for dumping handles, whose accesses
+ * have to be recorded call by call.
+ */
+Handle::HICANNHw* direct_access(Handle::HICANN& h)
+{
+	if (dynamic_cast<Handle::DumpMixin*>(&h))
+		return nullptr;
+	return dynamic_cast<Handle::HICANNHw*>(&h);
+}
+
+/// layer 1 and neuron configuration of apply(), in the order of writing
+std::vector<std::function<void()> > digital_config_steps(
+	Handle::HICANN& h, HICANNConfig const& config)
+{
+	std::vector<std::function<void()> > steps;
+
+	steps.push_back([&h, &config]() {
+		for (auto block : iter_all<RepeaterBlockOnHICANN>())
+			set_repeater_block(h, block, config.repeater_blocks[block.toEnum()]);
+	});
+	steps.push_back([&h, &config]() {
+		for (auto r : iter_all<VRepeaterOnHICANN>())
+			set_repeater(h, r, config.vertical_repeaters[r.toEnum()]);
+	});
+	steps.push_back([&h, &config]() {
+		for (auto r : iter_all<HRepeaterOnHICANN>())
+			set_repeater(h, r, config.horizontal_repeaters[r.toEnum()]);
+	});
+	steps.push_back([&h, &config]() {
+		for (auto y : iter_all<HLineOnHICANN>())
+			for (auto const s : { left, right })
+				set_crossbar_switch_row(h, y, s, config.crossbar.get_row(y, s));
+	});
+	steps.push_back([&h, &config]() {
+		for (auto s : iter_all<SynapseSwitchRowOnHICANN>())
+			set_syndriver_switch_row(h, s, config.synapse_switches.get_row(s));
+	});
+	steps.push_back([&h, &config]() {
+		set_merger_tree(h, config.merger_tree);
+		set_dnc_merger(h, config.dnc_mergers);
+		set_phase(h, config.phase);
+	});
+	steps.push_back([&h, &config]() {
+		for (auto q : iter_all<QuadOnHICANN>())
+			set_denmem_quad(h, q, config.denmem_quads[q.toEnum()]);
+	});
+	steps.push_back([&h, &config]() { set_neuron_config(h, config.neuron_config); });
+
+	return steps;
+}
+
+} // namespace
+
 /* macro usage:
  * HALBE_SETTER( function name, type1, variable name1, type2, variable name2, ... ) { }
  * HALBE_SETTER_GUARDED( configuration state event, function name, type1, variable name1, ... ) { }
@@ -50,6 +120,13 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 	Side const&, s,
 	HICANN::CrossbarRow const & , switches)
 {
+	auto const shadow = h.shadow_state();
+	if (shadow) {
+		if (shadow->unchanged(ShadowState::crossbar_row_t(y, s), switches))
+			return;
+		shadow->forget(ShadowState::crossbar_row_t(y, s), switches);
+	}
+
 	ReticleControl& reticle = *h.get_reticle();
 
 	// HLine 0 is the upper horizontal lane (according to the left crossbar)
@@ -67,6 +144,9 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 	}
 
 	reticle.hicann[h.jtag_addr()]->getLC(index).write_cfg(addr, cfg);
+
+	if (shadow)
+		shadow->written(ShadowState::crossbar_row_t(y, s), switches);
 }
 
 
@@ -102,6 +182,13 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 	SynapseSwitchRowOnHICANN const&, s,
 	SynapseSwitchRow const&, switches)
 {
+	auto const shadow = h.shadow_state();
+	if (shadow) {
+		if (shadow->unchanged(s, switches))
+			return;
+		shadow->forget(s, switches);
+	}
+
 	ReticleControl& reticle = *h.get_reticle();
 
 	ci_data_t cfg  = 0; //hardware-friendly data format
@@ -126,6 +213,9 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 	}
 
 	reticle.hicann[h.jtag_addr()]->getLC(index).write_cfg(addr, cfg);
+
+	if (shadow)
+		shadow->written(s, switches);
 }
 
 
@@ -168,6 +258,13 @@ HALBE_SETTER_GUARDED(EventSetupSynapses,
 	SynapseRowOnHICANN const&, s,
 	WeightRow const&, weights)
 {
+	auto const shadow = h.shadow_state();
+	if (shadow) {
+		if (shadow->unchanged(s, weights))
+			return;
+		shadow->forget(s, weights);
+	}
+
 	ReticleControl& reticle = *h.get_reticle();
 	auto& hicann = reticle.hicann[h.jtag_addr()];
 
@@ -176,9 +273,12 @@ HALBE_SETTER_GUARDED(EventSetupSynapses,
 			sc.write_data(instr.addr, instr.data);
 			if (instr.type == sc_write_data::WRITEANDWAIT) {
 				// wait until controller not busy
-				while(sc.arraybusy()) {}
+				wait_array_idle(sc);
 			}
 		});
+
+	if (shadow)
+		shadow->written(s, weights);
 }
 
 void set_weights_row(
@@ -191,29 +291,80 @@ void set_weights_row(
 		throw std::invalid_argument(
 			"set_weights_row: number of handles and data does not match");
 
-	// to buffer sc writes...
-	std::vector<sc_write_data_queue_t> per_hicann_queues(n_hicanns);
+	std::vector<BlockingCommandQueue> per_hicann_queues(n_hicanns);
+
+	for (size_t i = 0; i < n_hicanns; ++i) {
+		auto& hicann = dynamic_cast<HMF::Handle::HICANNHw&>(*handles[i]);
+		auto const shadow = hicann.shadow_state();
+		if (shadow) {
+			if (shadow->unchanged(s, data[i]))
+				continue;
+			shadow->forget(s, data[i]);
+		}
 
-	auto it_data = data.begin();
-	for (auto& queue : per_hicann_queues) {
-		set_weights_row_impl(s, *it_data, [&queue](sc_write_data const& instr) {
+		// to buffer sc writes...
+		sc_write_data_queue_t queue;
+		set_weights_row_impl(s, data[i], [&queue](sc_write_data const& instr) {
 			queue.push_back(instr);
 		});
-		++it_data;
+		push_sc_write_data(hicann, queue, per_hicann_queues[i]);
 	}
 
-	// per-hicann indices of progress within "write queues" (start at 0th entry)
-	std::vector<size_t> idxs(n_hicanns, 0);
+	apply(per_hicann_queues);
 
-	// as long as a single synapse controller hasn't finished...
-	for (bool all_done = false; !all_done;) {
-		all_done = true;
-		for (size_t i = 0; i < n_hicanns; ++i)
-			if (popexec_sc_write_data_queue(
-				    dynamic_cast<HMF::Handle::HICANNHw&>(*handles[i]), idxs[i],
-				    per_hicann_queues[i]))
-				all_done = false;
+	for (size_t i = 0; i < n_hicanns; ++i)
+		if (!per_hicann_queues[i].empty())
+			if (auto const shadow = dynamic_cast<HMF::Handle::HICANNHw&>(*handles[i]).shadow_state())
+				shadow->written(s, data[i]);
+}
+
+void set_weights(
+	Handle::HICANN & h,
+	std::vector<WeightRow> const& weights)
+{
+	if (weights.size() != SynapseRowOnHICANN::size)
+		throw std::invalid_argument(
+			"set_weights: weights of all synapse rows required");
+
+	auto* const hw = direct_access(h);
+	if (!hw) {
+		// nothing to interleave for other backends, dumping records each row
+		for (auto row : iter_all<SynapseRowOnHICANN>())
+			set_weights_row(h, row, weights[row.toEnum()]);
+		return;
+	}
+
+	CALL_SCHERIFF(EventSetupSynapses, set_weights, h);
+
+	auto const shadow = hw->shadow_state();
+	std::vector<SynapseRowOnHICANN> rows;
+	sc_write_data_queues_t queues;
+	for (auto row : iter_all<SynapseRowOnHICANN>()) {
+		if (shadow) {
+			if (shadow->unchanged(row, weights[row.toEnum()]))
+				continue;
+			shadow->forget(row, weights[row.toEnum()]);
+		}
+		push_weights_row(row, weights[row.toEnum()], queues);
+		rows.push_back(row);
 	}
+
+	ReticleControl& reticle = *hw->get_reticle();
+	auto& hicann = reticle.hicann[hw->jtag_addr()];
+
+	pipeline_sc_write_data_queues(
+		queues,
+		[&hicann](sc_write_data const& instr) {
+			hicann->getSC(instr.index).write_data(instr.addr, instr.data);
+		},
+		[&hicann](unsigned int const index) {
+			SynapseControl& sc = hicann->getSC(index);
+			wait_array_idle(sc); // wait until controller not busy
+		});
+
+	if (shadow)
+		for (auto const& row : rows)
+			shadow->written(row, weights[row.toEnum()]);
 }
 
 HALBE_GETTER(WeightRow, get_weights_row,
@@ -225,16 +376,7 @@ HALBE_GETTER(WeightRow, get_weights_row,
 	//calculate the correct hardware address of the line and choose the synapse block instance
 	uint32_t addr = 0;
 	HicannCtrl::Synapse index;
-	const SynapseDriverOnHICANN drv = s.toSynapseDriverOnHICANN();
-
-	if (drv.line() < 112) { //upper half of ANNCORE
-		addr = 223-(drv.line()*2) - (s.toRowOnSynapseDriver() == top ? 0 : 1);
-		index = HicannCtrl::SYNAPSE_TOP;
-	}
-	else {  //lower half of ANNCORE
-		addr = (drv.line()-112)*2 + (s.toRowOnSynapseDriver() == top ? 0 : 1); /// top/bottom here is geometrical, not hardware!
-		index = HicannCtrl::SYNAPSE_BOTTOM;
-	}
+	sc_weights_row_address(s, index, addr);
 
 	SynapseControl& sc = reticle.hicann[h.jtag_addr()]->getSC(index);
 
@@ -246,10 +388,10 @@ HALBE_GETTER(WeightRow, get_weights_row,
 				(1 << facets::SynapseControl::sc_newcmd_p) |
 				(addr << facets::SynapseControl::sc_adr_p);
 
-	WeightRow returnvalue;
+	std::array<std::bitset<32>, 32> data;
 
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, open_row); //open row for reading
-	while(sc.arraybusy()) {} //wait until controller not busy
+	wait_array_idle(sc); //wait until controller not busy
 
 	for (size_t colset = 0; colset < 8; colset++){
 		uint32_t read_command = facets::SynapseControl::sc_cmd_read | //put together a read command
@@ -258,21 +400,89 @@ HALBE_GETTER(WeightRow, get_weights_row,
 							(addr << facets::SynapseControl::sc_adr_p);
 
 		sc.write_data(facets::SynapseControl::sc_ctrlreg, read_command); //issue read command
-		while(sc.arraybusy()) {} //wait until not busy
-
-		for (size_t i = 0; i < 4; i++){ //single chunks in the columnset
-			std::bitset<32> sd = sc.read_data(facets::SynapseControl::sc_synout+i);
-			sd = bit::reverse(sd); // first "copy"
-			for (size_t j = 0; j < 8; j++) { //single synapse weights
-				returnvalue[64 * i + 8 * colset + j] =
-					SynapseWeight::from_bitset(bit::crop<4>(sd, 4 * j));
-			}
-		}
+		wait_array_idle(sc); //wait until not busy
+
+		for (size_t i = 0; i < 4; i++) //single chunks in the columnset
+			data[4 * colset + i] = sc.read_data(facets::SynapseControl::sc_synout+i);
 	}
 
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, close_row); //close row
-	while(sc.arraybusy()) {} //wait until not busy
-	return returnvalue;
+	wait_array_idle(sc); //wait until not busy
+	return weights_row_from_sc_data(data);
+}
+
+std::vector<WeightRow> get_weights(Handle::HICANN & h)
+{
+	std::vector<WeightRow> weights(SynapseRowOnHICANN::size);
+
+	auto* const hw = direct_access(h);
+	if (!hw) {
+		// dumping records each row
+		for (auto row : iter_all<SynapseRowOnHICANN>())
+			weights[row.toEnum()] = get_weights_row(h, row);
+		return weights;
+	}
+
+	ReticleControl& reticle = *hw->get_reticle();
+	auto& hicann = reticle.hicann[hw->jtag_addr()];
+
+	// raw output registers, unpacked after the readout
+	std::vector<std::array<std::bitset<32>, 32> > data(SynapseRowOnHICANN::size);
+
+	// one queue per synapse controller, which are read out interleaved
+	std::vector<BlockingCommandQueue> queues(2);
+	for (auto row : iter_all<SynapseRowOnHICANN>()) {
+		uint32_t addr = 0;
+		HicannCtrl::Synapse index;
+		sc_weights_row_address(row, index, addr);
+
+		SynapseControl& sc = hicann->getSC(index);
+		auto& queue = queues[index == HicannCtrl::SYNAPSE_TOP ? 0 : 1];
+		auto const busy = [&sc]() { return sc.arraybusy(); };
+		auto const command = [&sc, addr](uint32_t const cmd, size_t const colset) {
+			return [&sc, addr, cmd, colset]() {
+				sc.write_data(
+					facets::SynapseControl::sc_ctrlreg,
+					cmd | (colset << facets::SynapseControl::sc_colset_p) |
+						(1 << facets::SynapseControl::sc_newcmd_p) |
+						(addr << facets::SynapseControl::sc_adr_p));
+			};
+		};
+
+		queue.push_back({command(facets::SynapseControl::sc_cmd_st_rd, 0), busy}); //open row
+		for (size_t colset = 0; colset < 8; colset++) {
+			queue.push_back({command(facets::SynapseControl::sc_cmd_read, colset), busy});
+			auto& row_data = data[row.toEnum()];
+			queue.push_back({[&sc, &row_data, colset]() {
+				for (size_t i = 0; i < 4; i++) //single chunks in the columnset
+					row_data[4 * colset + i] = sc.read_data(facets::SynapseControl::sc_synout+i);
+			}, {}});
+		}
+		queue.push_back({command(facets::SynapseControl::sc_cmd_close, 0), busy}); //close row
+	}
+
+	apply(queues);
+
+	for (size_t ii = 0; ii < weights.size(); ++ii)
+		weights[ii] = weights_row_from_sc_data(data[ii]);
+	return weights;
+}
+
+std::vector<std::pair<SynapseRowOnHICANN, WeightRow> > verify_weights(
+	Handle::HICANN & h,
+	std::vector<WeightRow> const& expected)
+{
+	if (expected.size() != SynapseRowOnHICANN::size)
+		throw std::invalid_argument(
+			"verify_weights: weights of all synapse rows required");
+
+	auto const actual = get_weights(h);
+
+	std::vector<std::pair<SynapseRowOnHICANN, WeightRow> > mismatches;
+	for (auto row : iter_all<SynapseRowOnHICANN>())
+		if (!(actual[row.toEnum()] == expected[row.toEnum()]))
+			mismatches.push_back(std::make_pair(row, actual[row.toEnum()]));
+	return mismatches;
 }
 
 
@@ -282,6 +492,13 @@ HALBE_SETTER_GUARDED(EventSetupSynapses,
 	SynapseDriverOnHICANN const&, s,
 	DecoderDoubleRow const&, data)
 {
+	auto const shadow = h.shadow_state();
+	if (shadow) {
+		if (shadow->unchanged(s, data))
+			return;
+		shadow->forget(s, data);
+	}
+
 	ReticleControl& reticle = *h.get_reticle();
 	auto& hicann = reticle.hicann[h.jtag_addr()];
 
@@ -290,9 +507,12 @@ HALBE_SETTER_GUARDED(EventSetupSynapses,
 			sc.write_data(instr.addr, instr.data);
 			if (instr.type == sc_write_data::WRITEANDWAIT) {
 				// wait until controller not busy
-				while(sc.arraybusy()) {}
+				wait_array_idle(sc);
 			}
 		});
+
+	if (shadow)
+		shadow->written(s, data);
 }
 
 void set_decoder_double_row(
@@ -305,29 +525,31 @@ void set_decoder_double_row(
 		throw std::invalid_argument(
 			"set_decoder_double_row: number of handles and data does not match");
 
-	// to buffer sc writes...
-	std::vector<sc_write_data_queue_t> per_hicann_queues(n_hicanns);
+	std::vector<BlockingCommandQueue> per_hicann_queues(n_hicanns);
 
-	auto it_data = data.begin();
-	for (auto& queue : per_hicann_queues) {
-		set_decoder_double_row_impl(syndrv, *it_data, [&queue](sc_write_data const& instr) {
+	for (size_t i = 0; i < n_hicanns; ++i) {
+		auto& hicann = dynamic_cast<HMF::Handle::HICANNHw&>(*handles[i]);
+		auto const shadow = hicann.shadow_state();
+		if (shadow) {
+			if (shadow->unchanged(syndrv, data[i]))
+				continue;
+			shadow->forget(syndrv, data[i]);
+		}
+
+		// to buffer sc writes...
+		sc_write_data_queue_t queue;
+		set_decoder_double_row_impl(syndrv, data[i], [&queue](sc_write_data const& instr) {
 			queue.push_back(instr);
 		});
-		++it_data;
+		push_sc_write_data(hicann, queue, per_hicann_queues[i]);
 	}
 
-	// per-hicann indices of progress within "write queues" (start at 0th entry)
-	std::vector<size_t> idxs(n_hicanns, 0);
+	apply(per_hicann_queues);
 
-	// as long as a single synapse controller hasn't finished...
-	for (bool all_done = false; !all_done;) {
-		all_done = true;
-		for (size_t i = 0; i < n_hicanns; ++i)
-			if (popexec_sc_write_data_queue(
-				    dynamic_cast<HMF::Handle::HICANNHw&>(*handles[i]), idxs[i],
-				    per_hicann_queues[i]))
-				all_done = false;
-	}
+	for (size_t i = 0; i < n_hicanns; ++i)
+		if (!per_hicann_queues[i].empty())
+			if (auto const shadow = dynamic_cast<HMF::Handle::HICANNHw&>(*handles[i]).shadow_state())
+				shadow->written(syndrv, data[i]);
 }
 
 HALBE_GETTER(DecoderDoubleRow, get_decoder_double_row,
@@ -370,7 +592,7 @@ HALBE_GETTER(DecoderDoubleRow, get_decoder_double_row,
 	std::array<std::array<std::bitset<32>, 32>, 2> hwdata; //temporary data read from hardware
 	for (size_t ROW = TOP; ROW <= BOT; ROW++){ //loop over top/bottom rows
 		sc.write_data(facets::SynapseControl::sc_ctrlreg, open_row[ROW]); //open row for reading
-		while(sc.arraybusy()) {} //wait until controller not busy
+		wait_array_idle(sc); //wait until controller not busy
 
 		for (size_t colset = 0; colset < 8; colset++){
 			uint32_t read_command = facets::SynapseControl::sc_cmd_rdec | //put together a read command
@@ -379,14 +601,14 @@ HALBE_GETTER(DecoderDoubleRow, get_decoder_double_row,
 								(addr[ROW] << facets::SynapseControl::sc_adr_p);
 
 			sc.write_data(facets::SynapseControl::sc_ctrlreg, read_command); //issue read command
-			while(sc.arraybusy()) {} //wait until not busy
+			wait_array_idle(sc); //wait until not busy
 
 			for (size_t i = 0; i < 4; i++) //save single chunks in the columnset to the temporary container
 				hwdata[ROW][8*i + colset] = sc.read_data(facets::SynapseControl::sc_synout+i);
 		}
 
 		sc.write_data(facets::SynapseControl::sc_ctrlreg, close_row[ROW]); //close row
-		while(sc.arraybusy()) {} //wait until not busy
+		wait_array_idle(sc); //wait until not busy
 	}
 
 	//"unwrap" the hardware data by swapping bits in the correct order
@@ -404,112 +626,13 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 	SynapseDriver const&, driver)
 {
 	ReticleControl& reticle = *h.get_reticle();
+	auto& hicann = reticle.hicann[h.jtag_addr()];
 
-	//TOP/BOT here refers to hardware coordinates
-	bool TOP = top, BOT = bottom; //init with values where SW coords = HW coords (top half)
-
-	//calculate the correct hardware address of the line and choose the synapse block instance
-	uint32_t addr[2];
-	HicannCtrl::Synapse index;
-
-	if (s.line() < 112){ //upper half of ANNCORE
-		addr[BOT] = 222 - (s.line()*2);
-		addr[TOP] = 222 - (s.line()*2) + 1;
-		index = HicannCtrl::SYNAPSE_TOP;
-	}
-	else{ //lower half of ANNCORE, SW coords != HW coords
-		BOT = top;
-		TOP = bottom;
-		addr[BOT] = (s.line() - 112)*2;
-		addr[TOP] = (s.line() - 112)*2 + 1;
-		index = HicannCtrl::SYNAPSE_BOTTOM;
-	}
-	SynapseControl& sc = reticle.hicann[h.jtag_addr()]->getSC(index);
-
-	//put together necessary commands
-	uint32_t idle_command = 1 << facets::SynapseControl::sc_newcmd_p | facets::SynapseControl::sc_cmd_idle;
-
-	uint32_t dllreset_command = 0 << facets::SynapseControl::sc_cfg_dllresetb_p | //reset active
-							0xf << facets::SynapseControl::sc_cfg_predel_p |
-							0xf << facets::SynapseControl::sc_cfg_endel_p |
-							0xf << facets::SynapseControl::sc_cfg_oedel_p |
-							0x2 << facets::SynapseControl::sc_cfg_wrdel_p;
-
-	uint32_t config_command = 0x3 << facets::SynapseControl::sc_cfg_dllresetb_p | dllreset_command;
-
-	//convert data to hardware format
-	const std::bitset<8> zeropad = 0;
-	std::array<std::bitset<16>, 2> gmaxfrac;
-	std::array<std::bitset<16>, 2> preouts;
-	std::array<std::bitset<16>, 2> hwconfig;
-
-	typedef bitset<4> t4;
-	for (auto const& tt : { top, bottom }) {
-		gmaxfrac[tt] = bit::concat(t4(driver[tt].get_gmax_div(right)),
-								   t4(driver[tt].get_gmax_div(left))).to_ulong();
-	}
-
-	//hardware coords here as the preout values depend on each other and their hardware number
-	typedef bitset<2> t2;
-
-	t2 const p0(driver[RowOnSynapseDriver(BOT)].get_decoder(top));
-	t2 const p1(driver[RowOnSynapseDriver(TOP)].get_decoder(top));
-	t2 const p2(driver[RowOnSynapseDriver(BOT)].get_decoder(bottom));
-	t2 const p3(driver[RowOnSynapseDriver(TOP)].get_decoder(bottom));
-
-	preouts = encode_preouts(p0, p1, p2, p3);
-
-	hwconfig[BOT] = bit::concat(zeropad,
-				bit::convert<bool, 1>(driver.stp_enable),
-				bit::convert<bool, 1>(driver.enable),
-				bit::convert<bool, 1>(driver.locin),
-				bit::convert<bool, 1>(driver.connect_neighbor),
-				t2(driver[RowOnSynapseDriver(BOT)].get_gmax()),
-				bit::convert<bool, 1>(driver[RowOnSynapseDriver(BOT)].get_syn_in(right)),
-				bit::convert<bool, 1>(driver[RowOnSynapseDriver(BOT)].get_syn_in(left)));
-
-	hwconfig[TOP] = bit::concat(zeropad,
-				bit::convert<bool, 1>(driver.stp_mode),
-				driver.stp_cap,
-				t2(driver[RowOnSynapseDriver(TOP)].get_gmax()),
-				bit::convert<bool, 1>(driver[RowOnSynapseDriver(TOP)].get_syn_in(right)),
-				bit::convert<bool, 1>(driver[RowOnSynapseDriver(TOP)].get_syn_in(left)));
-
-	//right drivers have registers shifted by 8 bits
-	if (s.toSideHorizontal()==right) {
-		for (size_t i = std::min(TOP, BOT); i <= std::max(TOP, BOT); i++) {
-			gmaxfrac[i] = gmaxfrac[i] << 8;
-			preouts[i] = preouts[i] << 8;
-			hwconfig[i] = hwconfig[i] << 8;
-		}
-	}
-
-	//set DLL-reset active
-	while(sc.driverbusy()) {} //wait until controller not busy
-	// FIXME: should be done directly before experiment (for all dll-reset stuff)!
-	sc.write_data(facets::SynapseControl::sc_cnfgreg, dllreset_command);
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_ctrlreg, idle_command);
-	//write gmax divisors
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_engmax+addr[BOT], gmaxfrac[BOT].to_ulong());
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_engmax+addr[TOP], gmaxfrac[TOP].to_ulong());
-	//write preouts
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_endrv+addr[BOT], preouts[bottom].to_ulong());
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_endrv+addr[TOP], preouts[top].to_ulong());
-	//write driver configuration registers
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_encfg+addr[BOT], hwconfig[BOT].to_ulong());
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_encfg+addr[TOP], hwconfig[TOP].to_ulong());
-	//write the timings for the drivers and remove DLL reset
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_cnfgreg, config_command);
-	while(sc.driverbusy()) {}
-	sc.write_data(facets::SynapseControl::sc_ctrlreg, idle_command);
+	set_synapse_driver_impl(s, driver, [&hicann](sc_write_data const& instr) {
+		SynapseControl& sc = hicann->getSC(instr.index);
+		wait_driver_idle(sc); //wait until controller not busy
+		sc.write_data(instr.addr, instr.data);
+	});
 }
 
 
@@ -542,17 +665,17 @@ HALBE_GETTER(SynapseDriver, get_synapse_driver,
 	//read out the hardware registers
 	std::array<std::bitset<16>, 2> cnfg, pdrv, gmax;
 	for (size_t i = std::min(TOP, BOT); i <= std::max(TOP, BOT); i++) { //TOP/BOT
-		while(sc.driverbusy()) {} // TODO ECM: SF says => not necessary; only after next command
+		wait_driver_idle(sc); // TODO ECM: SF says => not necessary; only after next command
 		sc.read_data(facets::SynapseControl::sc_encfg+addr[i]);           // trigger read cycle
-		while(sc.driverbusy()) {}
+		wait_driver_idle(sc);
 		cnfg[i] = sc.read_data(facets::SynapseControl::sc_encfg+addr[i]); // retrieve read data
-		while(sc.driverbusy()) {} // TODO ECM: SF says => not necessary; only after next command
+		wait_driver_idle(sc); // TODO ECM: SF says => not necessary; only after next command
 		sc.read_data(facets::SynapseControl::sc_endrv+addr[i]);           // trigger
-		while(sc.driverbusy()) {}
+		wait_driver_idle(sc);
 		pdrv[i] = sc.read_data(facets::SynapseControl::sc_endrv+addr[i]); // retrieve
-		while(sc.driverbusy()) {} // TODO ECM: SF says => not necessary; only after next command
+		wait_driver_idle(sc); // TODO ECM: SF says => not necessary; only after next command
 		sc.read_data(facets::SynapseControl::sc_engmax+addr[i]);          // trigger
-		while(sc.driverbusy()) {}
+		wait_driver_idle(sc);
 		gmax[i] = sc.read_data(facets::SynapseControl::sc_endrv+addr[i]); // retrieve
 	}
 
@@ -602,6 +725,13 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 	QuadOnHICANN const&, qb,
 	NeuronQuad const&, nquad)
 {
+	auto const shadow = h.shadow_state();
+	if (shadow) {
+		if (shadow->unchanged(qb, nquad))
+			return;
+		shadow->forget(qb, nquad);
+	}
+
 	ReticleControl& reticle = *h.get_reticle();
 	auto& nbc = reticle.hicann[h.jtag_addr()]->getNBC();
 
@@ -612,6 +742,9 @@ HALBE_SETTER_GUARDED(EventSetupL1,
 		nbc.write_data(offset + NeuronQuad::getHWAddress(nrn),
 			denmen_quad_formatter(nrn, nquad).to_ulong());
 	}
+
+	if (shadow)
+		shadow->written(qb, nquad);
 }
 
 
@@ -1623,6 +1756,10 @@ HALBE_SETTER_GUARDED(EventStartExperiment,
 	std::bitset<1>(1), //enable correlation readout
 	std::bitset<4>(facets::SynapseControl::sc_cmd_auto)); //start autoupdate command
 
+	// the auto-update rewrites the weights
+	if (auto const shadow = h.shadow_state())
+		shadow->invalidate_weights();
+
 	//write control register
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, config_data.to_ulong());
 }
@@ -1642,7 +1779,7 @@ HALBE_SETTER_GUARDED(EventStartExperiment,
 	HicannCtrl::Synapse index = (y == top)? HicannCtrl::SYNAPSE_TOP : HicannCtrl::SYNAPSE_BOTTOM;
 	SynapseControl& sc = reticle.hicann[h.jtag_addr()]->getSC(index);
 
-	while(sc.arraybusy()) {}
+	wait_array_idle(sc);
 }
 
 
@@ -1699,7 +1836,7 @@ HALBE_SETTER_GUARDED(EventStartExperiment,
 	//write control register
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, config_data.to_ulong());
 	// wait until controller has completed up to lastaddr
-	while(sc.arraybusy()) {}
+	wait_array_idle(sc);
 
 	// set command to idle (not necessary to stop)
 	//format data
@@ -1716,7 +1853,7 @@ HALBE_SETTER_GUARDED(EventStartExperiment,
 		std::bitset<1>(1), //enable correlation readout
 		std::bitset<4>(facets::SynapseControl::sc_cmd_idle)); //auto command
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, config_data.to_ulong());
-	while(sc.arraybusy()) {}
+	wait_array_idle(sc);
 }
 
 
@@ -1766,7 +1903,7 @@ HALBE_SETTER_GUARDED(EventSetupSynapses,
 						(1 << facets::SynapseControl::sc_newcmd_p);
 
 		sc.write_data(SynapseControl::sc_ctrlreg, reset_command); //write reset command
-		while(sc.arraybusy()) {} //wait until controller not busy
+		wait_array_idle(sc); //wait until controller not busy
 	}
 }
 
@@ -1802,7 +1939,7 @@ HALBE_GETTER(STDPControl::corr_row, stdp_read_correlation,
 				(addr << facets::SynapseControl::sc_adr_p);
 
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, open_row); //open row for reading
-	while(sc.arraybusy()) {} //wait until controller not busy
+	wait_array_idle(sc); //wait until controller not busy
 
 	STDPControl::corr_row returnvalue; //256 x 2 array of bool
 
@@ -1816,7 +1953,7 @@ HALBE_GETTER(STDPControl::corr_row, stdp_read_correlation,
 							(addr << facets::SynapseControl::sc_adr_p);       //choose synapse row
 
 		sc.write_data(facets::SynapseControl::sc_ctrlreg, read_command); //issue read command
-		while(sc.arraybusy()) {} //wait until not busy
+		wait_array_idle(sc); //wait until not busy
 
 		std::bitset<32> causal = sc.read_data(facets::SynapseControl::sc_syncor);
 		std::bitset<32> acausal = sc.read_data(facets::SynapseControl::sc_syncor+1);
@@ -1833,7 +1970,7 @@ HALBE_GETTER(STDPControl::corr_row, stdp_read_correlation,
 	}
 
 	sc.write_data(facets::SynapseControl::sc_ctrlreg, close_row); //close row
-	while(sc.arraybusy()) {} //wait until not busy
+	wait_array_idle(sc); //wait until not busy
 
 	return returnvalue;
 }
@@ -1991,9 +2128,107 @@ HALBE_SETTER_GUARDED(EventResetWarm,
 	HicannCtrl& hc = *reticle.hicann[h.jtag_addr()];
 	DNCControl& dc = *reticle.dc;
 
+	if (auto const shadow = h.shadow_state())
+		shadow->invalidate();
 	hicann_init(hc, dc, h.isKintex(), zero_synapses);
 }
 
+void apply(Handle::HICANN & h, HICANNConfig const& config)
+{
+	if (config.decoders.size() != SynapseDriverOnHICANN::size)
+		throw std::invalid_argument("apply: decoders of all synapse drivers required");
+	if (config.weights.size() != SynapseRowOnHICANN::size)
+		throw std::invalid_argument("apply: weights of all synapse rows required");
+
+	auto* const hw = direct_access(h);
+	if (!hw) {
+		// nothing to interleave for other backends, dumping records each call
+		for (auto b : iter_all<FGBlockOnHICANN>())
+			set_fg_config(h, b, config.fg_config[b.toEnum()]);
+		set_fg_values(h, config.floating_gates);
+		for (auto const& step : digital_config_steps(h, config))
+			step();
+		for (auto drv : iter_all<SynapseDriverOnHICANN>()) {
+			set_synapse_driver(h, drv, config.synapse_drivers[drv.toEnum()]);
+			set_decoder_double_row(h, drv, config.decoders[drv.toEnum()]);
+		}
+		set_weights(h, config.weights);
+		set_background_generator(h, config.background_generators);
+		return;
+	}
+
+	// the floating gate configuration is two non-blocking writes per block, it is
+	// written beforehand so that the scheriff sees it before any layer 1 access
+	for (auto b : iter_all<FGBlockOnHICANN>())
+		set_fg_config(h, b, config.fg_config[b.toEnum()]);
+
+	std::vector<BlockingCommandQueue> queues;
+
+	// floating gate programming takes longest, start it first
+	for (auto b : iter_all<FGBlockOnHICANN>()) {
+		BlockingCommandQueue queue;
+		push_fg_values(*hw, b, config.floating_gates[b], queue);
+		queues.push_back(std::move(queue));
+	}
+
+	// synapse drivers, decoders and weights share the synapse controller of their half
+	std::array<BlockingCommandQueue, 2> synapse_queues;
+	for (auto drv : iter_all<SynapseDriverOnHICANN>()) {
+		auto& queue = synapse_queues[drv.line() < 112 ? 0 : 1];
+		push_synapse_driver(*hw, drv, config.synapse_drivers[drv.toEnum()], queue);
+	}
+
+	auto const shadow = hw->shadow_state();
+	std::vector<SynapseDriverOnHICANN> decoder_rows;
+	std::vector<SynapseRowOnHICANN> weight_rows;
+	sc_write_data_queues_t sc_data;
+	for (auto drv : iter_all<SynapseDriverOnHICANN>()) {
+		if (shadow) {
+			if (shadow->unchanged(drv, config.decoders[drv.toEnum()]))
+				continue;
+			shadow->forget(drv, config.decoders[drv.toEnum()]);
+		}
+		push_decoder_double_row(drv, config.decoders[drv.toEnum()], sc_data);
+		decoder_rows.push_back(drv);
+	}
+	for (auto row : iter_all<SynapseRowOnHICANN>()) {
+		if (shadow) {
+			if (shadow->unchanged(row, config.weights[row.toEnum()]))
+				continue;
+			shadow->forget(row, config.weights[row.toEnum()]);
+		}
+		push_weights_row(row, config.weights[row.toEnum()], sc_data);
+		weight_rows.push_back(row);
+	}
+	for (size_t i = 0; i < synapse_queues.size(); i++) {
+		push_sc_write_data(*hw, sc_data[i], synapse_queues[i]);
+		queues.push_back(std::move(synapse_queues[i]));
+	}
+
+	// the remaining controllers never block, interleave them step by step
+	BlockingCommandQueue digital;
+	for (auto& step : digital_config_steps(h, config))
+		digital.push_back(BlockingCommand::yielding(std::move(step)));
+	queues.push_back(std::move(digital));
+
+	// floating gate and synapse controller accesses bypass the dispatch
+	CALL_SCHERIFF(EventSetupFG, set_fg_values, h);
+	CALL_SCHERIFF(EventSetupL1, set_synapse_driver, h);
+	CALL_SCHERIFF(EventSetupSynapses, set_weights, h);
+
+	apply(queues);
+
+	if (shadow) {
+		for (auto const& drv : decoder_rows)
+			shadow->written(drv, config.decoders[drv.toEnum()]);
+		for (auto const& row : weight_rows)
+			shadow->written(row, config.weights[row.toEnum()]);
+	}
+
+	// background generators inject events, enable them once routing and neurons are set up
+	set_background_generator(h, config.background_generators);
+}
+
 
 HALBE_GETTER(Status, get_hicann_status,
 	Handle::HICANN &, h)
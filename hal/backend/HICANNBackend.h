@@ -1,5 +1,8 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 
 #include "hal/Coordinate/HMFGeometry.h"
@@ -77,12 +80,57 @@ void set_weights_row(
 	std::vector<boost::shared_ptr<Handle::HICANN> > handles,
 	Coordinate::SynapseRowOnHICANN const& s,
 	std::vector<WeightRow> const& data);
+
+/**
+ * Sets the weights of the whole synapse array.
+ *
+ * Both synapse controllers are written interleaved and the data of the next
+ * column set is transferred while the previous one is still being written to
+ * the array. For other backends and dumping handles set_weights_row() is
+ * called for each row instead.
+ *
+ * @param weights Weight rows indexed by SynapseRowOnHICANN enum.
+ * @throw std::invalid_argument If not all synapse rows are given.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+void set_weights(
+	Handle::HICANN & h,
+	std::vector<WeightRow> const& weights);
 #endif // !PYPLUSPLUS
 
 WeightRow get_weights_row(
 	Handle::HICANN & h,
 	Coordinate::SynapseRowOnHICANN const& s);
 
+#ifndef PYPLUSPLUS
+/**
+ * Reads the weights of the whole synapse array.
+ *
+ * Both synapse controllers are read out interleaved. For other backends and
+ * dumping handles get_weights_row() is called for each row instead.
+ *
+ * @return Weight rows indexed by SynapseRowOnHICANN enum.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+std::vector<WeightRow> get_weights(Handle::HICANN & h);
+
+/**
+ * Reads back the whole synapse array via get_weights(), i.e. row by row for
+ * dumping handles, and compares it to the expected weights.
+ *
+ * @param expected Weight rows indexed by SynapseRowOnHICANN enum.
+ * @return Mismatching rows with their actual weights, empty if all match.
+ * @throw std::invalid_argument If not all synapse rows are given.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+std::vector<std::pair<Coordinate::SynapseRowOnHICANN, WeightRow> > verify_weights(
+	Handle::HICANN & h,
+	std::vector<WeightRow> const& expected);
+#endif // !PYPLUSPLUS
+
 
 /**
  * Sets 4-bit decoder values for a double line (both lines driven by the same synapse driver)
@@ -579,6 +627,28 @@ void flush(Handle::HICANN& f);
 void init(Handle::HICANN & h, bool const zero_synapses = true);
 
 
+#ifndef PYPLUSPLUS
+/**
+ * Writes a complete HICANN configuration.
+ *
+ * The writes are grouped per controller: one queue per floating gate block,
+ * one per synapse controller (synapse drivers, decoders and weights) and one
+ * for the remaining layer 1 and neuron configuration. The queues are executed
+ * interleaved (cf. HICANN::apply(std::vector<BlockingCommandQueue> const&)),
+ * floating gate programming is issued first and proceeds while the digital
+ * configuration is written. Background generators are enabled last.
+ * For other backends and dumping handles the setters are called one by one.
+ *
+ * Writes of unchanged rows are skipped if a shadow state is attached.
+ *
+ * @throw std::invalid_argument If not all decoder or weight rows are given.
+ *
+ * @notice Performance-optimized function has not been exposed to Python.
+ */
+void apply(Handle::HICANN & h, HICANNConfig const& config);
+#endif // !PYPLUSPLUS
+
+
 /**
  * Prepare HICANN for an experiment.
  * To be called after configuring the HICANN.
@@ -1,6 +1,9 @@
+#include <array>
 #include <iostream>
 #include <chrono>
+#include <cstdint>
 #include "hal/backend/HICANNBackendHelper.h"
+#include "hal/backend/BusyWait.h"
 #include "hal/HICANN/FGInstruction.h"
 #include "hal/Coordinate/iter_all.h"
 
@@ -23,6 +26,71 @@ static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("halbe.backend.hic
 namespace HMF {
 namespace HICANN {
 
+namespace {
+
+/// 4 bit reversal, cf. SynapseWeight::format()
+std::array<uint8_t, 16> const reverse_nibble = {
+	{0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe, 0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf}};
+
+/// 4 bit results indexed by two 4 bit values (high << 4 | low)
+typedef std::array<uint8_t, 256> nibble_table_t;
+
+/// bit b of each entry is bit source[b] of its index
+nibble_table_t make_nibble_table(std::array<size_t, 4> const& source)
+{
+	nibble_table_t table;
+	for (size_t in = 0; in < table.size(); in++) {
+		uint8_t out = 0;
+		for (size_t b = 0; b < 4; b++)
+			out |= ((in >> source[b]) & 1) << b;
+		table[in] = out;
+	}
+	return table;
+}
+
+// Hardware nibbles of the decoder rows (MSB first, indexed by top << 4 | bot decoder):
+// top row: bot[3], top[2], bot[2], top[3]; bottom row: bot[1], top[0], bot[0], top[1]
+nibble_table_t const top_to_decoder_table = make_nibble_table({{7, 2, 6, 3}});
+nibble_table_t const bot_to_decoder_table = make_nibble_table({{5, 0, 4, 1}});
+// inverse, indexed by top << 4 | bot hardware nibble
+nibble_table_t const top_from_decoder_table = make_nibble_table({{2, 0, 6, 4}});
+nibble_table_t const bot_from_decoder_table = make_nibble_table({{1, 3, 5, 7}});
+
+std::array<std::bitset<32>, 32> to_decoder(
+	nibble_table_t const& table,
+	std::array<SynapseDecoder, 256> const& top,
+	std::array<SynapseDecoder, 256> const& bot)
+{
+	std::array<std::bitset<32>, 32> returnvalue;
+	for (size_t i = 0; i < 32; i++) { // single uints to write to HW
+		uint32_t word = 0;
+		for (size_t j = 0; j < 8; j++) // single 4-bit chunks, first one in the MSBs
+			word = (word << 4) | table[(top[8 * i + j].value() << 4) | bot[8 * i + j].value()];
+		returnvalue[i] = word;
+	}
+	return returnvalue;
+}
+
+std::array<SynapseDecoder, 256> from_decoder(
+	nibble_table_t const& table,
+	std::array<std::bitset<32>, 32> const& top,
+	std::array<std::bitset<32>, 32> const& bot)
+{
+	std::array<SynapseDecoder, 256> returnvalue;
+	for (size_t i = 0; i < 32; i++) {
+		uint32_t const t = top[i].to_ulong();
+		uint32_t const b = bot[i].to_ulong();
+		for (size_t j = 0; j < 8; j++) {
+			size_t const shift = 28 - 4 * j;
+			returnvalue[8 * i + j] =
+				SynapseDecoder(table[(((t >> shift) & 0xf) << 4) | ((b >> shift) & 0xf)]);
+		}
+	}
+	return returnvalue;
+}
+
+} // namespace
+
 void set_decoder_double_row_impl(
 	HMF::Coordinate::SynapseDriverOnHICANN const& s, HMF::HICANN::DecoderDoubleRow const& data,
 	std::function<void(sc_write_data const&)> callback)
@@ -86,25 +154,118 @@ void set_decoder_double_row_impl(
 	}
 }
 
-void set_weights_row_impl(
-	HMF::Coordinate::SynapseRowOnHICANN const& s, HMF::HICANN::WeightRow const& weights,
+void set_synapse_driver_impl(
+	HMF::Coordinate::SynapseDriverOnHICANN const& s, HMF::HICANN::SynapseDriver const& driver,
 	std::function<void(sc_write_data const&)> callback)
 {
 	using namespace facets;
 
-	// generate correctly formatted data for the hardware
-	std::array<std::bitset<32>, 32> hwdata;
-
-	for (size_t i = 0; i < 32; i++)
-		hwdata[i] = bit::concat(
-		    weights[8 * i + 0].format(), weights[8 * i + 1].format(), weights[8 * i + 2].format(),
-		    weights[8 * i + 3].format(), weights[8 * i + 4].format(), weights[8 * i + 5].format(),
-		    weights[8 * i + 6].format(), weights[8 * i + 7].format());
+	//TOP/BOT here refers to hardware coordinates
+	bool TOP = top, BOT = bottom; //init with values where SW coords = HW coords (top half)
 
-	// calculate the correct hardware address of the line and choose the synapse
-	// block instance
-	uint32_t addr = 0;
+	//calculate the correct hardware address of the line and choose the synapse block instance
+	uint32_t addr[2];
 	HicannCtrl::Synapse index;
+
+	if (s.line() < 112){ //upper half of ANNCORE
+		addr[BOT] = 222 - (s.line()*2);
+		addr[TOP] = 222 - (s.line()*2) + 1;
+		index = HicannCtrl::SYNAPSE_TOP;
+	}
+	else{ //lower half of ANNCORE, SW coords != HW coords
+		BOT = top;
+		TOP = bottom;
+		addr[BOT] = (s.line() - 112)*2;
+		addr[TOP] = (s.line() - 112)*2 + 1;
+		index = HicannCtrl::SYNAPSE_BOTTOM;
+	}
+
+	//put together necessary commands
+	uint32_t idle_command = 1 << facets::SynapseControl::sc_newcmd_p | facets::SynapseControl::sc_cmd_idle;
+
+	uint32_t dllreset_command = 0 << facets::SynapseControl::sc_cfg_dllresetb_p | //reset active
+							0xf << facets::SynapseControl::sc_cfg_predel_p |
+							0xf << facets::SynapseControl::sc_cfg_endel_p |
+							0xf << facets::SynapseControl::sc_cfg_oedel_p |
+							0x2 << facets::SynapseControl::sc_cfg_wrdel_p;
+
+	uint32_t config_command = 0x3 << facets::SynapseControl::sc_cfg_dllresetb_p | dllreset_command;
+
+	//convert data to hardware format
+	const std::bitset<8> zeropad = 0;
+	std::array<std::bitset<16>, 2> gmaxfrac;
+	std::array<std::bitset<16>, 2> preouts;
+	std::array<std::bitset<16>, 2> hwconfig;
+
+	typedef std::bitset<4> t4;
+	for (auto const& tt : { top, bottom }) {
+		gmaxfrac[tt] = bit::concat(t4(driver[tt].get_gmax_div(right)),
+								   t4(driver[tt].get_gmax_div(left))).to_ulong();
+	}
+
+	//hardware coords here as the preout values depend on each other and their hardware number
+	typedef std::bitset<2> t2;
+
+	t2 const p0(driver[RowOnSynapseDriver(BOT)].get_decoder(top));
+	t2 const p1(driver[RowOnSynapseDriver(TOP)].get_decoder(top));
+	t2 const p2(driver[RowOnSynapseDriver(BOT)].get_decoder(bottom));
+	t2 const p3(driver[RowOnSynapseDriver(TOP)].get_decoder(bottom));
+
+	preouts = encode_preouts(p0, p1, p2, p3);
+
+	hwconfig[BOT] = bit::concat(zeropad,
+				bit::convert<bool, 1>(driver.stp_enable),
+				bit::convert<bool, 1>(driver.enable),
+				bit::convert<bool, 1>(driver.locin),
+				bit::convert<bool, 1>(driver.connect_neighbor),
+				t2(driver[RowOnSynapseDriver(BOT)].get_gmax()),
+				bit::convert<bool, 1>(driver[RowOnSynapseDriver(BOT)].get_syn_in(right)),
+				bit::convert<bool, 1>(driver[RowOnSynapseDriver(BOT)].get_syn_in(left)));
+
+	hwconfig[TOP] = bit::concat(zeropad,
+				bit::convert<bool, 1>(driver.stp_mode),
+				driver.stp_cap,
+				t2(driver[RowOnSynapseDriver(TOP)].get_gmax()),
+				bit::convert<bool, 1>(driver[RowOnSynapseDriver(TOP)].get_syn_in(right)),
+				bit::convert<bool, 1>(driver[RowOnSynapseDriver(TOP)].get_syn_in(left)));
+
+	//right drivers have registers shifted by 8 bits
+	if (s.toSideHorizontal()==right) {
+		for (size_t i = std::min(TOP, BOT); i <= std::max(TOP, BOT); i++) {
+			gmaxfrac[i] = gmaxfrac[i] << 8;
+			preouts[i] = preouts[i] << 8;
+			hwconfig[i] = hwconfig[i] << 8;
+		}
+	}
+
+	auto const write = [&callback, index](uint32_t const reg, uint32_t const value) {
+		callback({index, sc_write_data::WRITE, reg, value});
+	};
+
+	//set DLL-reset active
+	// FIXME: should be done directly before experiment (for all dll-reset stuff)!
+	write(facets::SynapseControl::sc_cnfgreg, dllreset_command);
+	write(facets::SynapseControl::sc_ctrlreg, idle_command);
+	//write gmax divisors
+	write(facets::SynapseControl::sc_engmax+addr[BOT], gmaxfrac[BOT].to_ulong());
+	write(facets::SynapseControl::sc_engmax+addr[TOP], gmaxfrac[TOP].to_ulong());
+	//write preouts
+	write(facets::SynapseControl::sc_endrv+addr[BOT], preouts[bottom].to_ulong());
+	write(facets::SynapseControl::sc_endrv+addr[TOP], preouts[top].to_ulong());
+	//write driver configuration registers
+	write(facets::SynapseControl::sc_encfg+addr[BOT], hwconfig[BOT].to_ulong());
+	write(facets::SynapseControl::sc_encfg+addr[TOP], hwconfig[TOP].to_ulong());
+	//write the timings for the drivers and remove DLL reset
+	write(facets::SynapseControl::sc_cnfgreg, config_command);
+	write(facets::SynapseControl::sc_ctrlreg, idle_command);
+}
+
+void sc_weights_row_address(
+	HMF::Coordinate::SynapseRowOnHICANN const& s, facets::HicannCtrl::Synapse& index,
+	uint32_t& addr)
+{
+	using namespace facets;
+
 	const HMF::Coordinate::SynapseDriverOnHICANN drv = s.toSynapseDriverOnHICANN();
 
 	if (drv.line() < 112) { // upper half of ANNCORE
@@ -117,6 +278,49 @@ void set_weights_row_impl(
 		                                                                   /// hardware!
 		index = HicannCtrl::SYNAPSE_BOTTOM;
 	}
+}
+
+std::array<std::bitset<32>, 32> weights_to_sc_data(HMF::HICANN::WeightRow const& weights)
+{
+	std::array<std::bitset<32>, 32> returnvalue;
+	for (size_t i = 0; i < 32; i++) {
+		uint32_t word = 0;
+		for (size_t j = 0; j < 8; j++) // single synapse weights, first one in the MSBs
+			word = (word << 4) | reverse_nibble[weights[8 * i + j].value()];
+		returnvalue[i] = word;
+	}
+	return returnvalue;
+}
+
+HMF::HICANN::WeightRow weights_row_from_sc_data(std::array<std::bitset<32>, 32> const& data)
+{
+	WeightRow returnvalue;
+	for (size_t colset = 0; colset < 8; colset++) {
+		for (size_t i = 0; i < 4; i++) { // single chunks in the columnset
+			uint32_t const sd = data[4 * colset + i].to_ulong();
+			for (size_t j = 0; j < 8; j++) { // single synapse weights, first one in the MSBs
+				returnvalue[64 * i + 8 * colset + j] =
+					SynapseWeight(reverse_nibble[(sd >> (28 - 4 * j)) & 0xf]);
+			}
+		}
+	}
+	return returnvalue;
+}
+
+void set_weights_row_impl(
+	HMF::Coordinate::SynapseRowOnHICANN const& s, HMF::HICANN::WeightRow const& weights,
+	std::function<void(sc_write_data const&)> callback)
+{
+	using namespace facets;
+
+	// generate correctly formatted data for the hardware
+	std::array<std::bitset<32>, 32> const hwdata = weights_to_sc_data(weights);
+
+	// calculate the correct hardware address of the line and choose the synapse
+	// block instance
+	uint32_t addr = 0;
+	HicannCtrl::Synapse index;
+	sc_weights_row_address(s, index, addr);
 
 	// write the data to hardware: columnset-wise
 	for (size_t colset = 0; colset < 8; colset++) {
@@ -137,38 +341,22 @@ void set_weights_row_impl(
 	}
 }
 
-bool popexec_sc_write_data_queue(
-    HMF::Handle::HICANNHw& h, size_t& idx, sc_write_data_queue_t const& data)
+void push_weights_row(
+	HMF::Coordinate::SynapseRowOnHICANN const& s, HMF::HICANN::WeightRow const& weights,
+	sc_write_data_queues_t& queues)
 {
-	using namespace facets;
-
-	size_t const n_data = data.size();
-
-	if (idx >= n_data)
-		return false;
-
-	ReticleControl& reticle = *h.get_reticle();
-
-	// batch of writes to do...
-	if (data[idx].type == sc_write_data::WRITE) {
-		for (; idx < n_data; ++idx) {
-			SynapseControl& sc = reticle.hicann[h.jtag_addr()]->getSC(data[idx].index);
-			sc.write_data(data[idx].addr, data[idx].data);
-			// look-ahead and return if the next would be blocking...
-			if (data[idx].type == sc_write_data::WRITEANDWAIT)
-				// Do not increase index, the next call to this function will
-				// busy wait (and not write, see below).
-				break;
-		}
-	} else if (data[idx].type == sc_write_data::WRITEANDWAIT) { // it's a ARRAYBUSY check, do it...
-		SynapseControl& sc = reticle.hicann[h.jtag_addr()]->getSC(data[idx].index);
-		while(sc.arraybusy());
-		idx++;
-	} else {
-		throw std::runtime_error("Cannot happen");
-	}
+	set_weights_row_impl(s, weights, [&queues](sc_write_data const& instr) {
+		queues[instr.index == facets::HicannCtrl::SYNAPSE_TOP ? 0 : 1].push_back(instr);
+	});
+}
 
-	return true;
+void push_decoder_double_row(
+	HMF::Coordinate::SynapseDriverOnHICANN const& s, HMF::HICANN::DecoderDoubleRow const& data,
+	sc_write_data_queues_t& queues)
+{
+	set_decoder_double_row_impl(s, data, [&queues](sc_write_data const& instr) {
+		queues[instr.index == facets::HicannCtrl::SYNAPSE_TOP ? 0 : 1].push_back(instr);
+	});
 }
 
 /** builds neuron builder configuration byte */
@@ -299,20 +487,7 @@ top_to_decoder(
 	std::array<SynapseDecoder, 256> const& top,
 	std::array<SynapseDecoder, 256> const& bot)
 {
-	std::array<std::bitset<32>, 32> returnvalue;
-
-	for (size_t i = 0; i < 32; i++){ //single uints to write to HW
-		for (size_t j = 0; j < 8; j++){ //single 4-bit chunks
-			std::bitset<4> ttop(top[8*i+j]);
-			std::bitset<4> tbot(bot[8*i+j]);
-			returnvalue[i][31-4*j]     = tbot[3];
-			returnvalue[i][31-(4*j+1)] = ttop[2];
-			returnvalue[i][31-(4*j+2)] = tbot[2];
-			returnvalue[i][31-(4*j+3)] = ttop[3];
-		}
-	}
-
-	return returnvalue;
+	return to_decoder(top_to_decoder_table, top, bot);
 }
 
 /** returns a line of bottom decoders to be written to hardware. already includes reverting the bits */
@@ -321,20 +496,7 @@ bot_to_decoder(
 	std::array<SynapseDecoder, 256> const& top,
 	std::array<SynapseDecoder, 256> const& bot)
 {
-	std::array<std::bitset<32>, 32> returnvalue;
-
-	for (size_t i = 0; i < 32; i++){ //single uints to write to HW
-		for (size_t j = 0; j < 8; j++){ //single 4-bit chunks
-			std::bitset<4> ttop(top[8*i+j]);
-			std::bitset<4> tbot(bot[8*i+j]);
-			returnvalue[i][31-4*j]     = tbot[1];
-			returnvalue[i][31-(4*j+1)] = ttop[0];
-			returnvalue[i][31-(4*j+2)] = tbot[0];
-			returnvalue[i][31-(4*j+3)] = ttop[1];
-		}
-	}
-
-	return returnvalue;
+	return to_decoder(bot_to_decoder_table, top, bot);
 }
 
 /** decodes and returns a line of 256 top decoder values read from the hardware */
@@ -343,18 +505,7 @@ top_from_decoder(
 	std::array<std::bitset<32>, 32> const& top,
 	std::array<std::bitset<32>, 32> const& bot)
 {
-	std::array<SynapseDecoder, 256> returnvalue;
-
-	for (size_t i = 0; i < 256; i++){
-		std::bitset<4> t;
-		t[0] = bot[i/8][31-(4*(i%8)+1)];
-		t[1] = bot[i/8][31-(4*(i%8)+3)];
-		t[2] = top[i/8][31-(4*(i%8)+1)];
-		t[3] = top[i/8][31-(4*(i%8)+3)];
-		returnvalue[i] = SynapseDecoder(t.to_ulong());
-	}
-
-	return returnvalue;
+	return from_decoder(top_from_decoder_table, top, bot);
 }
 
 /** decodes and returns a line of 256 bottom decoder values read from the hardware */
@@ -363,18 +514,7 @@ bot_from_decoder(
 	std::array<std::bitset<32>, 32> const& top,
 	std::array<std::bitset<32>, 32> const& bot)
 {
-	std::array<SynapseDecoder, 256> returnvalue;
-
-	for (size_t i = 0; i < 256; i++){
-		std::bitset<4> t;
-		t[0] = bot[i/8][31-(4*(i%8)+2)];
-		t[1] = bot[i/8][31-4*(i%8)];
-		t[2] = top[i/8][31-(4*(i%8)+2)];
-		t[3] = top[i/8][31-4*(i%8)];
-		returnvalue[i] = SynapseDecoder(t.to_ulong());
-	}
-
-	return returnvalue;
+	return from_decoder(bot_from_decoder_table, top, bot);
 }
 
 /** encodes 4x2 MSBs of the synapse decoders to be written to hardware */
@@ -402,15 +542,12 @@ encode_preouts(
 	//returnvalue[TOP][6] = gen[1]; // p[3][2]
 	//returnvalue[TOP][7] = gen[0]; // p[3][3]
 
-	returnvalue[BOT][0] = p0[0]; // p[0][0]
-	returnvalue[BOT][1] = p1[1]; // p[0][1]
-	returnvalue[BOT][2] = p0[1]; // p[0][2]
-	returnvalue[BOT][3] = p1[0]; // p[0][3]
-
-	returnvalue[BOT][4] = p2[0]; // p[2][0]
-	returnvalue[BOT][5] = p3[1]; // p[2][1]
-	returnvalue[BOT][6] = p2[1]; // p[2][2]
-	returnvalue[BOT][7] = p3[0]; // p[2][3]
+	// bits of each side: bottom[0], top[1], bottom[1], top[0] (LSB first)
+	auto const side = [](std::bitset<2> const bottom, std::bitset<2> const top) {
+		unsigned long const b = bottom.to_ulong(), t = top.to_ulong();
+		return (b & 1) | (t & 2) | ((b & 2) << 1) | ((t & 1) << 3);
+	};
+	returnvalue[BOT] = side(p0, p1) | (side(p2, p3) << 4);
 
 	return returnvalue;
 }
@@ -428,15 +565,13 @@ decode_preouts(
 	enum { TOP = 0, BOT = 1 }; //HARDWARE-TOP/BOTTOM
 	enum { LEFT = 0, RIGHT = 1 };
 
-	returnvalue[BOT][LEFT][0]  = dbot[0]; //bottom left HW
-	returnvalue[BOT][LEFT][1]  = dbot[2];
-	returnvalue[TOP][LEFT][0]  = dbot[3]; //top left HW
-	returnvalue[TOP][LEFT][1]  = dbot[1];
-
-	returnvalue[BOT][RIGHT][0] = dbot[4]; //bottom right HW
-	returnvalue[BOT][RIGHT][1] = dbot[6];
-	returnvalue[TOP][RIGHT][0] = dbot[7]; //top right HW
-	returnvalue[TOP][RIGHT][1] = dbot[5];
+	// inverse of encode_preouts()
+	unsigned long const d = dbot.to_ulong();
+	for (size_t side = LEFT; side <= RIGHT; side++) {
+		unsigned long const n = (d >> (4 * side)) & 0xf;
+		returnvalue[BOT][side] = (n & 1) | ((n >> 1) & 2);
+		returnvalue[TOP][side] = ((n >> 3) & 1) | (n & 2);
+	}
 
 	return returnvalue;
 }
@@ -580,10 +715,11 @@ FGErrorResultRow fg_log_error(
 
 			// Retry to get controller status if controller was busy (last read
 			// contains invalid data otherwise)
-			do {
+			busy_wait(WaitingController::floating_gate, [&h, &b, &data]() {
 				data = FGErrorResult{fg_read_answer(h, b)};
 				LOG4CXX_TRACE(fglogger, "read value " << std::bitset<32>(data.get_slave_answer_data()));
-			} while(data.get_busy_flag());
+				return data.get_busy_flag();
+			});
 		}
 
 		// break when seeing an invalid result
@@ -629,18 +765,12 @@ FGErrorResultRow fg_busy_wait(
 	FGBlockOnHICANN const& b,
 	int row)
 {
-	using namespace std::chrono;
-	bool busy;
+	// Worst timing for a single row should be about 1.37s, cf. busy_wait_timeout()
 	ci_data_t value;
-	// Worst timing for a single row should be about 1.37s
-	auto end_time = system_clock::now() + seconds(10);
-	do {
-		if (system_clock::now() > end_time)
-			throw std::runtime_error("fg_busy_wait timeout");
+	busy_wait(WaitingController::floating_gate, [&h, &b, &value]() {
 		value = fg_read_answer(h, b);
-
-		busy = FGErrorResult{value}.get_busy_flag();
-	} while (busy);
+		return FGErrorResult{value}.get_busy_flag();
+	});
 	return fg_log_error(h, b, row, value);
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <functional>
 
 #include <bitter/integral.h>
@@ -40,12 +41,60 @@ void set_decoder_double_row_impl(
 	HMF::Coordinate::SynapseDriverOnHICANN const& s, HMF::HICANN::DecoderDoubleRow const& data,
 	std::function<void(sc_write_data const&)> callback);
 
+/**
+ * synapse controller writes configuring a synapse driver, the drivers of the
+ * controller have to be idle before each of them (cf. SynapseControl::driverbusy())
+ */
+void set_synapse_driver_impl(
+	HMF::Coordinate::SynapseDriverOnHICANN const& s, HMF::HICANN::SynapseDriver const& driver,
+	std::function<void(sc_write_data const&)> callback);
+
+/** hardware address of a synapse row and the synapse controller it belongs to */
+void sc_weights_row_address(
+	HMF::Coordinate::SynapseRowOnHICANN const& s, facets::HicannCtrl::Synapse& index,
+	uint32_t& addr);
+
+/** formats a weight row for the synapse controller, word i holds the weights 8 * i to 8 * i + 7 */
+std::array<std::bitset<32>, 32> weights_to_sc_data(HMF::HICANN::WeightRow const& weights);
+
+/**
+ * unpacks a weight row read from the synapse controller, data[4 * colset + i]
+ * is output register i after reading column set colset
+ */
+HMF::HICANN::WeightRow weights_row_from_sc_data(std::array<std::bitset<32>, 32> const& data);
+
 void set_weights_row_impl(
 	HMF::Coordinate::SynapseRowOnHICANN const& s, HMF::HICANN::WeightRow const& weights,
 	std::function<void(sc_write_data const&)> callback);
 
-bool popexec_sc_write_data_queue(
-    HMF::Handle::HICANNHw& h, size_t& idx, sc_write_data_queue_t const& data);
+/** write queues of the top and bottom synapse controller (in this order) */
+typedef std::array<sc_write_data_queue_t, 2> sc_write_data_queues_t;
+
+/** appends the writes of a weight row to the queue of its synapse controller */
+void push_weights_row(
+	HMF::Coordinate::SynapseRowOnHICANN const& s, HMF::HICANN::WeightRow const& weights,
+	sc_write_data_queues_t& queues);
+
+/** appends the writes of a decoder double row to the queue of its synapse controller */
+void push_decoder_double_row(
+	HMF::Coordinate::SynapseDriverOnHICANN const& s, HMF::HICANN::DecoderDoubleRow const& data,
+	sc_write_data_queues_t& queues);
+
+/**
+ * Executes the write queues of both synapse controllers interleaved, one
+ * column set (data writes and flush) per controller at a time.
+ *
+ * The data writes of the next column set are issued while the previous flush
+ * of the same controller may still be busy, i.e. @a wait is only called right
+ * before the next flush and for all controllers at the end.
+ *
+ * @param write Called as write(instr) for each queued instruction in order.
+ * @param wait  Called as wait(index) with the synapse controller index, has to
+ *              block until the controller is not busy.
+ */
+template <typename Write, typename Wait>
+void pipeline_sc_write_data_queues(
+	sc_write_data_queues_t const& queues, Write const& write, Wait const& wait);
 
 /** builds neuron builder configuration byte */
 std::bitset<25> nbdata(
@@ -146,6 +195,8 @@ FGErrorResultRow fg_log_error(
  *
  * @returns error messages that were read out from
  *     the floating gate controller.
+ * @throw BusyWaitTimeout If still busy after
+ *     busy_wait_timeout(WaitingController::floating_gate).
  */
 FGErrorResultRow fg_busy_wait(
 	Handle::HICANNHw & h,
@@ -292,6 +343,46 @@ Repeater get_repeater_helper(
 }
 
 
+template <typename Write, typename Wait>
+void pipeline_sc_write_data_queues(
+	sc_write_data_queues_t const& queues, Write const& write, Wait const& wait)
+{
+	std::array<size_t, 2> idxs = {{0, 0}};
+	// index of the controller whose last flush may still be busy, per queue
+	std::array<unsigned int, 2> pending;
+	std::array<bool, 2> is_pending = {{false, false}};
+
+	for (bool all_done = false; !all_done;) {
+		all_done = true;
+		for (size_t q = 0; q < queues.size(); ++q) {
+			auto const& queue = queues[q];
+			size_t& idx = idxs[q];
+			if (idx >= queue.size())
+				continue;
+			all_done = false;
+
+			// data writes only go to the input registers...
+			for (; idx < queue.size() && queue[idx].type == sc_write_data::WRITE; ++idx)
+				write(queue[idx]);
+			if (idx >= queue.size())
+				continue;
+
+			// ...whereas the flush has to wait for the previous one
+			sc_write_data const& flush = queue[idx++];
+			if (is_pending[q])
+				wait(pending[q]);
+			write(flush);
+			pending[q] = flush.index;
+			is_pending[q] = true;
+		}
+	}
+
+	for (size_t q = 0; q < queues.size(); ++q)
+		if (is_pending[q])
+			wait(pending[q]);
+}
+
+
 /**
  * Configures the multiplier of the HICANN PLL. The Resulting frequency will be
  * a multiple of 100MHz up to 250MHz. This controls the clock of all synchronous
@@ -0,0 +1,192 @@
+#include "hal/backend/LoopbackTransport.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "hal/backend/TraceDecoder.h"
+
+namespace HMF {
+namespace FPGA {
+
+size_t const LoopbackTransport::max_packet_words;
+
+static_assert(
+	sizeof(sctrltp::packet::pdu) >= LoopbackTransport::max_packet_words * sizeof(std::uint64_t),
+	"HostARQ packets are too small");
+
+namespace {
+
+// Entry encoding of the trace memory, cf. TraceDecoder.
+std::uint32_t const no_pulse_entry = 1u << 30;
+
+std::uint32_t pulse_entry(PulseAddress::label_t const label, PulseEvent::spiketime_t const time)
+{
+	std::uint32_t const timestamp = time % TraceDecoder::max_timestamp_count;
+	std::uint32_t const fpga_msb = timestamp >> (TraceDecoder::event_timestamp_bits - 1);
+	return (fpga_msb << 29) | (std::uint32_t(label & 0xfff) << TraceDecoder::event_timestamp_bits) |
+	       timestamp;
+}
+
+std::uint32_t overflow_entry(std::uint64_t const count)
+{
+	return (1u << 31) | std::uint32_t(count & 0x7fffffff);
+}
+
+std::uint64_t trace_word(std::uint32_t const lower, std::uint32_t const upper)
+{
+	return (std::uint64_t(upper) << 32) | lower;
+}
+
+} // namespace
+
+LoopbackTransport::Config::Config()
+	: latency(std::chrono::microseconds(10)),
+	  jitter(std::chrono::microseconds(0)),
+	  realtime(false),
+	  reorder_probability(0.),
+	  drop_probability(0.),
+	  seed(0)
+{
+}
+
+LoopbackTransport::LoopbackTransport(Config const& config)
+	: m_config(config),
+	  m_rng(config.seed),
+	  m_packets(),
+	  m_uploaded_pulses(0),
+	  m_lost_pulses(0),
+	  m_trace_packets(0)
+{
+	auto const is_probability = [](double const p) { return p >= 0. && p <= 1.; };
+	if (!is_probability(m_config.reorder_probability) ||
+	    !is_probability(m_config.drop_probability))
+		throw std::invalid_argument("LoopbackTransport: probabilities have to be within [0, 1]");
+}
+
+bool LoopbackTransport::upload_playback(
+	PlaybackPulseEncoder::buffer_type const& pulses,
+	std::uint64_t const end_of_experiment_timestamp)
+{
+	auto const start = clock_type::now();
+	m_packets.clear();
+	m_uploaded_pulses = pulses.size();
+	m_trace_packets = 0;
+	send(record(pulses), start, end_of_experiment_timestamp);
+	return true;
+}
+
+bool LoopbackTransport::receive(sctrltp::packet& packet)
+{
+	if (m_packets.empty() || m_packets.front().available > clock_type::now())
+		return false;
+
+	auto const& words = m_packets.front().words;
+	packet.pid = application_layer_packet_types::FPGATRACE;
+	packet.len = words.size();
+	std::copy(words.begin(), words.end(), packet.pdu);
+	m_packets.pop_front();
+	return true;
+}
+
+std::vector<LoopbackTransport::TraceEntry> LoopbackTransport::record(
+	PlaybackPulseEncoder::buffer_type const& pulses)
+{
+	std::vector<TraceEntry> entries;
+	entries.reserve(pulses.size());
+
+	std::bernoulli_distribution drop(m_config.drop_probability);
+	bool const may_drop = m_config.drop_probability > 0.;
+	for (auto const& pulse : pulses) {
+		if (may_drop && drop(m_rng))
+			continue;
+		entries.push_back(TraceEntry{pulse.hicann_time, PulseAddress::label_t(pulse.label & 0xfff)});
+	}
+	m_lost_pulses = pulses.size() - entries.size();
+
+	// Late entries are only swapped within a timestamp window, as the overflow
+	// indicators in between would assign them to the wrong one.
+	if (m_config.reorder_probability > 0.) {
+		std::bernoulli_distribution reorder(m_config.reorder_probability);
+		for (size_t ii = 0; ii + 1 < entries.size(); ++ii) {
+			if (entries[ii].time / TraceDecoder::max_timestamp_count ==
+			        entries[ii + 1].time / TraceDecoder::max_timestamp_count &&
+			    reorder(m_rng)) {
+				std::swap(entries[ii], entries[ii + 1]);
+				++ii;
+			}
+		}
+	}
+	return entries;
+}
+
+void LoopbackTransport::send(
+	std::vector<TraceEntry> const& entries,
+	clock_type::time_point const start,
+	std::uint64_t const end_of_experiment_timestamp)
+{
+	TracePacket packet;
+	packet.words.reserve(max_packet_words);
+
+	auto const flush = [this, &packet, start](PulseEvent::spiketime_t const time) {
+		if (packet.words.empty())
+			return;
+		packet.available = arrival(start, time);
+		m_packets.push_back(std::move(packet));
+		++m_trace_packets;
+		packet.words.clear();
+		packet.words.reserve(max_packet_words);
+	};
+	auto const push = [&packet, &flush](
+		std::uint32_t const lower, std::uint32_t const upper, PulseEvent::spiketime_t const time) {
+		packet.words.push_back(trace_word(lower, upper));
+		if (packet.words.size() == max_packet_words)
+			flush(time);
+	};
+
+	std::uint64_t overflow_count = 0;
+	bool has_lower = false;
+	std::uint32_t lower = 0;
+	PulseEvent::spiketime_t time = 0;
+	for (auto const& entry : entries) {
+		time = entry.time;
+		// overflow indicators are only valid as upper entry
+		while (entry.time / TraceDecoder::max_timestamp_count > overflow_count) {
+			++overflow_count;
+			push(has_lower ? lower : no_pulse_entry, overflow_entry(overflow_count), time);
+			has_lower = false;
+		}
+		if (has_lower) {
+			push(lower, pulse_entry(entry.label, entry.time), time);
+			has_lower = false;
+		} else {
+			lower = pulse_entry(entry.label, entry.time);
+			has_lower = true;
+		}
+	}
+	if (has_lower)
+		push(lower, no_pulse_entry, time);
+	flush(time);
+
+	packet.words.push_back(TraceDecoder::end_of_trace_marker);
+	flush(2 * end_of_experiment_timestamp);
+}
+
+LoopbackTransport::clock_type::time_point LoopbackTransport::arrival(
+	clock_type::time_point const start, PulseEvent::spiketime_t const time)
+{
+	clock_type::time_point available = start + m_config.latency;
+	if (m_config.realtime)
+		available += std::chrono::nanoseconds(time * 1000 / DNC_frequency_in_MHz);
+	if (m_config.jitter.count() > 0) {
+		std::uniform_int_distribution<std::int64_t> jitter(0, m_config.jitter.count());
+		available += std::chrono::microseconds(jitter(m_rng));
+	}
+	// packets are received in order
+	if (!m_packets.empty())
+		available = std::max(available, m_packets.back().available);
+	return available;
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "hal/backend/PulseTransport.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief In-process stand-in for the HostARQ connection of an FPGA whose
+ *        playback is looped back to its trace.
+ *
+ * Each uploaded playback pulse is recorded in the trace at its time, with the
+ * 12 bit label seen by the trace (i.e. without the DNC part). The trace is
+ * sent as FPGATRACE packets including overflow indicators and terminated by the
+ * end-of-trace marker, as by the FPGA. Latency, jitter, reordering and loss
+ * of pulse events are configurable, all random decisions are reproducible by
+ * the seed.
+ *
+ * This allows measuring the throughput and latency of the host side of the
+ * pulse data path without hardware:
+ * @code
+ * LoopbackTransport transport;
+ * write_playback_pulses(transport, events, runtime, fpga_hicann_delay);
+ * auto const trace = read_trace_pulses(transport, fpga, runtime, TraceEventFilter());
+ * @endcode
+ */
+class LoopbackTransport : public PulseTransport
+{
+public:
+	typedef std::chrono::steady_clock clock_type;
+
+	/// 64 bit words per HostARQ packet (MAX_PDUWORDS).
+	static const size_t max_packet_words = 176;
+
+	struct Config
+	{
+		Config();
+
+		/// Delay of each packet after the recording of its last entry.
+		std::chrono::microseconds latency;
+		/// Maximum additional random delay of each packet, packets stay in order.
+		std::chrono::microseconds jitter;
+		/// Whether the trace is recorded in (wall clock) experiment time. Otherwise
+		/// the whole trace is available right after the upload (plus latency).
+		bool realtime;
+		/// Probability of a pulse event being recorded after its successor.
+		double reorder_probability;
+		/// Probability of a pulse event not being recorded.
+		double drop_probability;
+		std::uint64_t seed;
+	};
+
+	/**
+	 * @throw std::invalid_argument If a probability is not within [0, 1].
+	 */
+	explicit LoopbackTransport(Config const& config = Config());
+
+	/// Replaces the trace of a previous upload, also if it was not read out completely.
+	bool upload_playback(
+		PlaybackPulseEncoder::buffer_type const& pulses,
+		std::uint64_t end_of_experiment_timestamp) override;
+
+	bool receive(sctrltp::packet& packet) override;
+
+	Config const& config() const { return m_config; }
+
+	/// Number of pulses of the last upload.
+	size_t uploaded_pulses() const { return m_uploaded_pulses; }
+	/// Number of pulses of the last upload not recorded in the trace.
+	size_t lost_pulses() const { return m_lost_pulses; }
+	/// Number of trace packets (including the end-of-trace marker) of the last upload.
+	size_t trace_packets() const { return m_trace_packets; }
+	/// Number of trace packets not received yet.
+	size_t pending_packets() const { return m_packets.size(); }
+
+private:
+	struct TracePacket
+	{
+		clock_type::time_point available;
+		std::vector<std::uint64_t> words;
+	};
+
+	struct TraceEntry
+	{
+		PulseEvent::spiketime_t time;
+		PulseAddress::label_t label;
+	};
+
+	std::vector<TraceEntry> record(PlaybackPulseEncoder::buffer_type const& pulses);
+	void send(
+		std::vector<TraceEntry> const& entries,
+		clock_type::time_point start,
+		std::uint64_t end_of_experiment_timestamp);
+	clock_type::time_point arrival(
+		clock_type::time_point start, PulseEvent::spiketime_t time);
+
+	Config const m_config;
+	std::mt19937_64 m_rng;
+
+	std::deque<TracePacket> m_packets;
+	size_t m_uploaded_pulses;
+	size_t m_lost_pulses;
+	size_t m_trace_packets;
+};
+
+} // namespace FPGA
+} // namespace HMF
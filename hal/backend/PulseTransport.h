@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "hal/FPGA/PlaybackPulses.h"
+#include "sctrltp/ARQStream.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Connection moving playback pulses to and trace packets from an FPGA.
+ *
+ * On hardware this is the HostARQ connection of the FPGA handle. The pulse
+ * data path of write_playback_pulses() and read_trace_pulses() only depends on
+ * this interface, hence it can also be run against an in-process stand-in, cf.
+ * LoopbackTransport.
+ */
+class PulseTransport
+{
+public:
+	virtual ~PulseTransport() {}
+
+	/**
+	 * Sends encoded playback pulses followed by the end-of-experiment marker,
+	 * which also stops the trace recording and starts the trace readout.
+	 *
+	 * @param end_of_experiment_timestamp In FPGA clock cycles.
+	 * @return Whether all playback frames were sent.
+	 */
+	virtual bool upload_playback(
+		PlaybackPulseEncoder::buffer_type const& pulses,
+		std::uint64_t end_of_experiment_timestamp) = 0;
+
+	/**
+	 * Polls for the next received packet without blocking.
+	 *
+	 * @return Whether @a packet was filled.
+	 */
+	virtual bool receive(sctrltp::packet& packet) = 0;
+};
+
+} // namespace FPGA
+} // namespace HMF
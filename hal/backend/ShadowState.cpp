@@ -0,0 +1,21 @@
+#include "hal/backend/ShadowState.h"
+
+namespace HMF {
+namespace HICANN {
+
+void ShadowState::invalidate()
+{
+	m_weights.clear();
+	m_decoders.clear();
+	m_crossbar_switches.clear();
+	m_syndriver_switches.clear();
+	m_denmem_quads.clear();
+}
+
+void ShadowState::invalidate_weights()
+{
+	m_weights.clear();
+}
+
+} // HICANN
+} // HMF
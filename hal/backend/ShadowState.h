@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <utility>
+
+#include "hal/Coordinate/HMFGeometry.h"
+#include "hal/HICANNContainer.h"
+
+namespace HMF {
+namespace HICANN {
+
+/**
+ * @brief Opt-in cache of the configuration last written to a HICANN.
+ *
+ * If attached to a hardware handle, the setters of synapse weight rows,
+ * decoder double rows, crossbar and synapse driver switch rows and denmem
+ * quads skip the hardware access if the same container was written to the
+ * same coordinate before:
+ * @code
+ * h.set_shadow_state(boost::make_shared<HICANN::ShadowState>());
+ * @endcode
+ *
+ * Entries are forgotten before a changed container is written and only
+ * remembered once the write succeeded, a partially failed write hence never
+ * leaves a stale entry behind.
+ *
+ * The cache assumes to be the only writer of the configuration. It is
+ * invalidated by HICANN::init() and FPGA::reset(), the synapse weights
+ * additionally by HICANN::start_stdp() as the STDP auto-update rewrites them.
+ * Other ways of changing the hardware state (e.g. direct access via the
+ * reticle) require an explicit invalidate().
+ */
+class ShadowState
+{
+public:
+	struct Counters
+	{
+		Counters() : issued(0), skipped(0) {}
+
+		/// Number of containers written to the hardware.
+		size_t issued;
+		/// Number of containers not written as they were unchanged.
+		size_t skipped;
+	};
+
+	typedef std::pair<Coordinate::HLineOnHICANN, Coordinate::Side> crossbar_row_t;
+
+	/// Returns whether @a value was last written to @a c, counting a skipped write if so.
+	template <typename Key, typename Value>
+	bool unchanged(Key const& c, Value const& value);
+
+	/// Remembers @a value as last written to @a c, counting an issued write.
+	template <typename Key, typename Value>
+	void written(Key const& c, Value const& value);
+
+	/// Forgets the container of type @a Value last written to @a c, to be called before writing it.
+	template <typename Key, typename Value>
+	void forget(Key const& c, Value const& value);
+
+	/// Forgets all written containers, the counters are kept.
+	void invalidate();
+
+	/// Forgets all written synapse weights, the counters are kept.
+	void invalidate_weights();
+
+	Counters const& counters() const { return m_counters; }
+	void reset_counters() { m_counters = Counters(); }
+
+private:
+	std::map<Coordinate::SynapseRowOnHICANN, WeightRow>& cache(WeightRow const&)
+	{
+		return m_weights;
+	}
+	std::map<Coordinate::SynapseDriverOnHICANN, DecoderDoubleRow>& cache(DecoderDoubleRow const&)
+	{
+		return m_decoders;
+	}
+	std::map<crossbar_row_t, CrossbarRow>& cache(CrossbarRow const&)
+	{
+		return m_crossbar_switches;
+	}
+	std::map<Coordinate::SynapseSwitchRowOnHICANN, SynapseSwitchRow>& cache(SynapseSwitchRow const&)
+	{
+		return m_syndriver_switches;
+	}
+	std::map<Coordinate::QuadOnHICANN, NeuronQuad>& cache(NeuronQuad const&)
+	{
+		return m_denmem_quads;
+	}
+
+	std::map<Coordinate::SynapseRowOnHICANN, WeightRow> m_weights;
+	std::map<Coordinate::SynapseDriverOnHICANN, DecoderDoubleRow> m_decoders;
+	std::map<crossbar_row_t, CrossbarRow> m_crossbar_switches;
+	std::map<Coordinate::SynapseSwitchRowOnHICANN, SynapseSwitchRow> m_syndriver_switches;
+	std::map<Coordinate::QuadOnHICANN, NeuronQuad> m_denmem_quads;
+
+	Counters m_counters;
+};
+
+template <typename Key, typename Value>
+bool ShadowState::unchanged(Key const& c, Value const& value)
+{
+	auto const& cached = cache(value);
+	auto const it = cached.find(c);
+	if (it == cached.end() || !(it->second == value))
+		return false;
+	++m_counters.skipped;
+	return true;
+}
+
+template <typename Key, typename Value>
+void ShadowState::forget(Key const& c, Value const& value)
+{
+	cache(value).erase(c);
+}
+
+template <typename Key, typename Value>
+void ShadowState::written(Key const& c, Value const& value)
+{
+	auto& cached = cache(value);
+	auto const it = cached.find(c);
+	if (it == cached.end())
+		cached.insert(std::make_pair(c, value));
+	else
+		it->second = value;
+	++m_counters.issued;
+}
+
+} // HICANN
+} // HMF
@@ -0,0 +1,420 @@
+#include "hal/backend/TraceDecoder.h"
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/config.hpp>
+#include <log4cxx/logger.h>
+
+#include "hal/Coordinate/FormatHelper.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define HALBE_TRACE_DECODER_AVX2
+#include <immintrin.h>
+#endif
+
+static log4cxx::LoggerPtr logger = log4cxx::Logger::getLogger("halbe.backend.fpga");
+
+#define HALBE_RTP_TRACE(message) \
+	{ \
+		if (LOG4CXX_UNLIKELY(m_trace_enabled)) { \
+			::log4cxx::helpers::MessageBuffer oss_; \
+			logger->forcedLog( \
+			    ::log4cxx::Level::getTrace(), oss_.str(oss_ << message), LOG4CXX_LOCATION); \
+		} \
+	}
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+union entry_type
+{
+	std::uint32_t raw;
+	// A pulse event is indicated by two '0' high-order bits.  The sequence '01'
+	// is used to mark the absence of a pulse event in a packet that contains an
+	// overflow indicator.
+	struct
+	{
+		// LSBs of pulse event timestamp, MSBs are transmitted via overflow indicators.
+		unsigned int timestamp : TraceDecoder::event_timestamp_bits;
+		// Label of pulse event, as described below.
+		unsigned int label : 12;
+		unsigned int : 2; // padding
+		// MSB of the FPGA systime counter.
+		unsigned int fpga_msb : 1;
+		// Two zero-bits, to encode entry type.
+		unsigned int zero_bits : 2;
+	} event;
+	// An overflow indicator is indicated by a '1' high-order bit.
+	struct
+	{
+		unsigned int count : 31;
+		unsigned int is_overflow : 1;
+	} overflow;
+};
+
+// A pulse event label consists of 12 bit used as follows:
+// |     3bit    |   3bit   |    6bit   |
+// | HICANNOnDNC | GbitLink | L1Address |
+// Each pulse label will be converted to a 16 bit PulseAddress,
+// where the additional 4 bit remain unused.
+
+// Raw bit positions of the fields above, used by the block decoder.
+static constexpr std::uint32_t timestamp_mask = (1u << TraceDecoder::event_timestamp_bits) - 1;
+static constexpr unsigned int label_shift = TraceDecoder::event_timestamp_bits;
+static constexpr std::uint32_t label_mask = 0xfff;
+static constexpr unsigned int fpga_msb_bit = 29;
+
+// The block decoder works on four 64 bit words, i.e. eight entries. Overflow
+// indicators are only valid in the upper entry (odd index) of each word.
+static constexpr size_t block_words = 4;
+static constexpr unsigned int odd_entries = 0xaa;
+static constexpr unsigned int even_entries = 0x55;
+
+inline unsigned int popcount(unsigned int const mask)
+{
+	return __builtin_popcount(mask);
+}
+
+} // namespace
+
+constexpr std::uint64_t TraceDecoder::end_of_trace_marker;
+constexpr size_t TraceDecoder::event_timestamp_bits;
+constexpr std::uint64_t TraceDecoder::max_timestamp_count;
+
+bool TraceDecoder::avx2_supported()
+{
+#ifdef HALBE_TRACE_DECODER_AVX2
+	static bool const supported = __builtin_cpu_supports("avx2");
+	return supported;
+#else
+	return false;
+#endif // HALBE_TRACE_DECODER_AVX2
+}
+
+TraceDecoder::TraceDecoder(
+	Coordinate::FPGAGlobal const& fpga,
+	bool const drop_background_events,
+	Implementation const implementation)
+	: TraceDecoder(fpga, background_filter(drop_background_events), implementation)
+{
+}
+
+TraceDecoder::TraceDecoder(
+	Coordinate::FPGAGlobal const& fpga,
+	TraceEventFilter const& filter,
+	Implementation const implementation)
+	: m_fpga(fpga),
+	  m_filter(filter),
+	  m_filter_events(!filter.accepts_all()),
+	  m_implementation(implementation),
+	  m_trace_enabled(logger->isTraceEnabled()),
+	  m_overflow_count(0),
+	  m_dropped_events(0),
+	  m_received_events(0),
+	  m_events(),
+	  m_has_last_event(false),
+	  m_last_event()
+{
+	if (m_implementation == Implementation::automatic)
+		m_implementation = avx2_supported() ? Implementation::avx2 : Implementation::reference;
+	if (m_implementation == Implementation::avx2 && !avx2_supported())
+		throw std::invalid_argument("TraceDecoder: AVX2 is not supported on this host");
+}
+
+bool TraceDecoder::decode(std::uint64_t const* const words, size_t const num_words)
+{
+	m_received_events = 0;
+
+	// Each word holds at most two pulse events; writing into preallocated storage
+	// is considerably faster than appending event by event.
+	m_events.resize(2 * num_words);
+	PulseEvent* out = m_events.data();
+
+	// Trace logging reports every single entry, which only the reference decoder does.
+	size_t decoded_words = 0;
+#ifdef HALBE_TRACE_DECODER_AVX2
+	if (!m_trace_enabled && m_implementation == Implementation::avx2)
+		decoded_words = decode_avx2(words, num_words, out);
+#endif // HALBE_TRACE_DECODER_AVX2
+
+	bool const received_eot = decode_reference(words, decoded_words, num_words, out);
+	m_events.resize(out - m_events.data());
+
+#ifndef NDEBUG
+	check_duplicates();
+#endif // !NDEBUG
+	if (!m_events.empty()) {
+		m_has_last_event = true;
+		m_last_event = m_events.back();
+	}
+	return received_eot;
+}
+
+bool TraceDecoder::decode_reference(
+	std::uint64_t const* const words, size_t const begin, size_t const num_words, PulseEvent*& out)
+{
+	entry_type const* const entries = reinterpret_cast<entry_type const*>(words);
+
+	for (size_t ii = 2 * begin; ii < 2 * num_words; ++ii) {
+
+		// check for end-of-trace marker every 64-bit word
+		if ((ii % 2) == 0) {
+			if (words[ii/2] == end_of_trace_marker) {
+				if (((ii/2) + 1) < num_words) {
+					std::stringstream debug_msg;
+					debug_msg << HMF::Coordinate::short_format(m_fpga)
+					          << " unexpected end-of-trace marker"
+					             " within other data: " << ii / 2 << " out of "
+					          << (num_words - 1) << ".\n"
+					          << " Next entry looks like: " << std::hex
+					          << words[(ii / 2) + 1] << std::dec
+					          << "\n";
+					LOG4CXX_ERROR(logger, debug_msg.str());
+					// FIXME: we should throw std::runtime_error(debug_msg.str()); here
+				}
+				// packet handling done, bail out
+				return true;
+			}
+		}
+
+		// non-eot data handling below
+		auto const& entry = entries[ii];
+
+		if (entry.overflow.is_overflow) {
+			if (BOOST_UNLIKELY(ii % 2 != 1)) {
+#ifndef NDEBUG
+				// Overflow entries should only occur at odd indices.
+				LOG4CXX_WARN(logger,
+				             HMF::Coordinate::short_format(m_fpga)
+				                 << " garbage overflow entry at even index " << ii
+				                 << ": " << std::showbase << std::hex << entry.raw
+				                 << " (issue 2355)");
+#endif // !NDEBUG
+				continue;
+			}
+			m_overflow_count += 1;
+
+#ifndef NDEBUG
+			HALBE_RTP_TRACE(
+				"overflow packet " << m_overflow_count
+				<< std::showbase
+				<< " with value " << std::hex << entry.overflow.count
+				<< " (" << std::dec << entry.overflow.count << ")" << " received.\n"
+				<< " current offset is " << std::hex << m_overflow_count * max_timestamp_count
+				<< " (" << std::dec << m_overflow_count * max_timestamp_count << ")");
+
+			if (m_overflow_count != entry.overflow.count) {
+				LOG4CXX_WARN(
+				    logger,
+				    HMF::Coordinate::short_format(m_fpga)
+				        << " Local overflow count " << m_overflow_count
+				        << " does not match contents of overflow indicator "
+				        << entry.overflow.count);
+			}
+#endif // !NDEBUG
+
+			continue;
+		} else if (entry.event.zero_bits != 0) {
+			// no overflow, no spike => garbage
+			continue;
+		}
+
+		std::uint64_t full_timestamp =
+			static_cast<std::uint64_t>(entry.event.timestamp) +
+			m_overflow_count * max_timestamp_count;
+		bool timestamp_msb = entry.event.timestamp >> (event_timestamp_bits - 1);
+
+		// Detect special case that HICANN timestamp was registered before
+		// overflow, but pulse arrives in FPGA after overflow and an overflow
+		// packet was generated.
+		if (timestamp_msb && !entry.event.fpga_msb) {
+			if (full_timestamp < max_timestamp_count) {
+				// Ignore early pulses.
+				continue;
+			}
+			// Undo last overflow for that pulse.
+			full_timestamp -= max_timestamp_count;
+		}
+
+#ifndef NDEBUG
+		HALBE_RTP_TRACE(
+			"received pulse event " << m_received_events << " (entry " << ii << "):\n"
+			<< std::showbase
+			<< "id: " << std::hex << entry.event.label << ", "
+			<< "timestamp: " << std::hex << entry.event.timestamp
+			<< " (" << std::dec << entry.event.timestamp << ")" << ", "
+			<< "msb timestamp/fpga: " << timestamp_msb << "/" << entry.event.fpga_msb << ",\n"
+			<< "full timestamp: " << std::hex << full_timestamp
+			<< " (" << std::dec << full_timestamp << ")");
+#endif // !NDEBUG
+
+		// Update the count of received pulse events unconditionally, as it is
+		// used to decide when to timeout.
+		++m_received_events;
+
+		if (m_filter_events && !m_filter.accepts(entry.event.label, full_timestamp)) {
+			++m_dropped_events;
+			continue;
+		}
+
+		*out++ = PulseEvent(PulseAddress(entry.event.label), full_timestamp);
+	}
+	return false;
+}
+
+#ifdef HALBE_TRACE_DECODER_AVX2
+__attribute__((target("avx2,popcnt")))
+size_t TraceDecoder::decode_avx2(
+	std::uint64_t const* const words, size_t const num_words, PulseEvent*& out)
+{
+	__m256i const zero = _mm256_setzero_si256();
+	__m256i const one = _mm256_set1_epi32(1);
+	__m256i const marker = _mm256_set1_epi64x(static_cast<long long>(end_of_trace_marker));
+	__m256i const odd_lanes = _mm256_set_epi32(1, 0, 1, 0, 1, 0, 1, 0);
+	__m256i const last_of_lower_half = _mm256_set1_epi32(3);
+	__m256i const timestamps = _mm256_set1_epi32(timestamp_mask);
+	__m256i const labels = _mm256_set1_epi32(label_mask);
+
+	alignas(32) std::uint64_t full_timestamps[2 * block_words];
+	alignas(32) std::uint32_t raw_labels[2 * block_words];
+
+	size_t ww = 0;
+	for (; ww + block_words <= num_words; ww += block_words) {
+		__m256i const raw = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(words + ww));
+
+		__m256i const eot = _mm256_cmpeq_epi64(raw, marker);
+		if (BOOST_UNLIKELY(!_mm256_testz_si256(eot, eot)))
+			break;
+
+		// classify all entries of the block, MSB of each lane is the overflow flag
+		unsigned int overflow = _mm256_movemask_ps(_mm256_castsi256_ps(raw));
+		unsigned int const event = _mm256_movemask_ps(
+		    _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_srli_epi32(raw, 30), zero)));
+		unsigned int const adjust =
+		    _mm256_movemask_ps(_mm256_castsi256_ps(
+		        _mm256_slli_epi32(raw, 31 - (event_timestamp_bits - 1)))) &
+		    ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(raw, 31 - fpga_msb_bit)));
+
+#ifndef NDEBUG
+		// misplaced overflow indicators are reported by the reference decoder
+		if (BOOST_UNLIKELY(overflow & even_entries))
+			break;
+		check_overflow_indicators(
+		    reinterpret_cast<std::uint32_t const*>(words + ww), overflow, m_overflow_count);
+#endif // !NDEBUG
+		overflow &= odd_entries;
+
+		if (event) {
+			// exclusive prefix count of overflow indicators per lane
+			__m256i const overflows = _mm256_and_si256(_mm256_srli_epi32(raw, 31), odd_lanes);
+			__m256i prefix = _mm256_add_epi32(overflows, _mm256_slli_si256(overflows, 4));
+			prefix = _mm256_add_epi32(prefix, _mm256_slli_si256(prefix, 8));
+			prefix = _mm256_add_epi32(
+			    prefix, _mm256_blend_epi32(
+			                zero, _mm256_permutevar8x32_epi32(prefix, last_of_lower_half), 0xf0));
+			prefix = _mm256_sub_epi32(prefix, overflows);
+
+			// full timestamp = timestamp + (overflow count - adjust) * max_timestamp_count
+			__m256i const adjusts = _mm256_and_si256(
+			    _mm256_srli_epi32(raw, event_timestamp_bits - 1),
+			    _mm256_andnot_si256(_mm256_srli_epi32(raw, fpga_msb_bit), one));
+			__m256i const offsets = _mm256_sub_epi32(prefix, adjusts);
+			__m256i const lsbs = _mm256_and_si256(raw, timestamps);
+			__m256i const base = _mm256_set1_epi64x(static_cast<long long>(m_overflow_count));
+
+			__m256i const lower = _mm256_add_epi64(
+			    _mm256_cvtepu32_epi64(_mm256_castsi256_si128(lsbs)),
+			    _mm256_slli_epi64(
+			        _mm256_add_epi64(
+			            base, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(offsets))),
+			        event_timestamp_bits));
+			__m256i const upper = _mm256_add_epi64(
+			    _mm256_cvtepu32_epi64(_mm256_extracti128_si256(lsbs, 1)),
+			    _mm256_slli_epi64(
+			        _mm256_add_epi64(
+			            base, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(offsets, 1))),
+			        event_timestamp_bits));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(full_timestamps), lower);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(full_timestamps + block_words), upper);
+			_mm256_store_si256(
+			    reinterpret_cast<__m256i*>(raw_labels),
+			    _mm256_and_si256(_mm256_srli_epi32(raw, label_shift), labels));
+
+			// early pulses (adjusted without any preceding overflow) are ignored
+			unsigned int keep = event;
+			if (m_overflow_count == 0)
+				keep &= ~(adjust & static_cast<unsigned int>(_mm256_movemask_ps(
+				                       _mm256_castsi256_ps(_mm256_cmpeq_epi32(prefix, zero)))));
+			m_received_events += popcount(keep);
+
+			for (; keep; keep &= keep - 1) {
+				unsigned int const ii = __builtin_ctz(keep);
+				if (m_filter_events && !m_filter.accepts(raw_labels[ii], full_timestamps[ii])) {
+					++m_dropped_events;
+					continue;
+				}
+				*out++ = PulseEvent(PulseAddress(raw_labels[ii]), full_timestamps[ii]);
+			}
+		}
+
+		m_overflow_count += popcount(overflow);
+	}
+	return ww;
+}
+#endif // HALBE_TRACE_DECODER_AVX2
+
+void TraceDecoder::check_overflow_indicators(
+	std::uint32_t const* const entries, unsigned int mask, std::uint64_t count) const
+{
+	for (mask &= odd_entries; mask; mask &= mask - 1) {
+		entry_type entry;
+		entry.raw = entries[__builtin_ctz(mask)];
+		++count;
+		if (count != entry.overflow.count) {
+			LOG4CXX_WARN(
+			    logger,
+			    HMF::Coordinate::short_format(m_fpga)
+			        << " Local overflow count " << count
+			        << " does not match contents of overflow indicator "
+			        << entry.overflow.count);
+		}
+	}
+}
+
+void TraceDecoder::check_duplicates() const
+{
+	// Old bug where trace memory potentially stored pulse twice while
+	// sending overflow packet, should not occur anymore.
+	// TODO 2016-04-27: Remove check when it's absolutely sure that the bug is
+	// fixed.
+	for (size_t ii = 0; ii < m_events.size(); ++ii) {
+		PulseEvent const* last_event = nullptr;
+		if (ii > 0)
+			last_event = &m_events[ii - 1];
+		else if (m_has_last_event)
+			last_event = &m_last_event;
+		else
+			continue;
+
+		PulseEvent const& event = m_events[ii];
+		if (last_event->getLabel() == event.getLabel() &&
+		    (last_event->getTime() == event.getTime() ||
+		     (last_event->getTime() + max_timestamp_count) == event.getTime())) {
+			LOG4CXX_WARN(logger,
+			             HMF::Coordinate::short_format(m_fpga)
+			                 << " received pulse twice (issue 2022): "
+			                 << last_event->getTime() << " == " << event.getTime()
+			                 << "\n(spike " << ii << "/" << m_events.size()
+			                 << " of ARQ frame) with label " << event.getLabel());
+		}
+	}
+}
+
+} // namespace FPGA
+} // namespace HMF
+
+#undef HALBE_RTP_TRACE
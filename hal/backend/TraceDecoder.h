@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hal/Coordinate/HMFGeometry.h"
+#include "hal/FPGAContainer.h"
+#include "hal/FPGA/TraceEventFilter.h"
+
+namespace HMF {
+namespace FPGA {
+
+/**
+ * @brief Decoder for the FPGA trace memory pulse data received via HostARQ.
+ *
+ * Handles all entry types described in section "I-10.2.1. FPGA Trace / Pulse Data"
+ * of the specification, i.e. pulse entries and overflow indicators, and keeps
+ * track of the overflow count needed to reconstruct full timestamps across
+ * packets. Each 64 bit word of a packet consists of two entries aligned to 32 bit.
+ *
+ * Besides the portable reference implementation (one entry at a time) there is
+ * an AVX2 block decoder, which is used if supported by the host CPU. It
+ * classifies four words (eight entries) at once and calculates the overflow
+ * offsets of all entries by a prefix count of the overflow indicators. Both
+ * implementations yield identical results; rare cases (end-of-trace marker,
+ * misplaced overflow indicators, trace logging) are always handled by the
+ * reference implementation.
+ */
+class TraceDecoder
+{
+public:
+	typedef AlmostSortedPulseEvents::container_type container_type;
+
+	enum class Implementation
+	{
+		automatic,
+		reference,
+		avx2
+	};
+
+	static constexpr std::uint64_t end_of_trace_marker = 0x4000E11D40000000ull;
+	static constexpr size_t event_timestamp_bits = 15;
+	static constexpr std::uint64_t max_timestamp_count = 1ull << event_timestamp_bits;
+
+	/// Whether the AVX2 block decoder can be used on this host.
+	static bool avx2_supported();
+
+	/**
+	 * @param fpga Coordinate of the FPGA the trace is read from, only used for logging.
+	 * @param drop_background_events Whether pulse events with L1 address zero should be dropped.
+	 * @param implementation Decoder implementation, @c automatic selects the fastest one.
+	 * @throw std::invalid_argument If AVX2 is requested but not supported.
+	 */
+	TraceDecoder(
+		Coordinate::FPGAGlobal const& fpga,
+		bool drop_background_events,
+		Implementation implementation = Implementation::automatic);
+
+	/**
+	 * @param filter Selection of pulse events, others are counted as dropped.
+	 */
+	TraceDecoder(
+		Coordinate::FPGAGlobal const& fpga,
+		TraceEventFilter const& filter,
+		Implementation implementation = Implementation::automatic);
+
+	/**
+	 * Decodes the 64 bit words of a single FPGATRACE packet.
+	 *
+	 * Previously decoded events are discarded, the events of this packet are
+	 * available via events() afterwards.
+	 *
+	 * @return Whether the end-of-trace marker was received.
+	 */
+	bool decode(std::uint64_t const* words, size_t num_words);
+
+	/// Pulse events (without dropped ones) of the last decoded packet.
+	container_type const& events() const { return m_events; }
+
+	/// Number of received pulse events (including dropped ones) of the last decoded packet.
+	std::uint64_t received_events() const { return m_received_events; }
+
+	/// Total number of dropped pulse events.
+	size_t dropped_events() const { return m_dropped_events; }
+
+	/// Total number of overflow indicators.
+	std::uint64_t overflow_count() const { return m_overflow_count; }
+
+	Implementation implementation() const { return m_implementation; }
+
+private:
+	// Decode (remaining) words and write events to @a out, the block decoder
+	// returns the number of decoded words.
+	bool decode_reference(
+		std::uint64_t const* words, size_t begin, size_t num_words, PulseEvent*& out);
+	size_t decode_avx2(std::uint64_t const* words, size_t num_words, PulseEvent*& out);
+
+	void check_overflow_indicators(
+		std::uint32_t const* entries, unsigned int mask, std::uint64_t count) const;
+	void check_duplicates() const;
+
+	Coordinate::FPGAGlobal m_fpga;
+	TraceEventFilter m_filter;
+	bool m_filter_events;
+	Implementation m_implementation;
+	bool m_trace_enabled;
+
+	std::uint64_t m_overflow_count;
+	size_t m_dropped_events;
+	std::uint64_t m_received_events;
+	container_type m_events;
+
+	bool m_has_last_event;
+	PulseEvent m_last_event;
+};
+
+} // namespace FPGA
+} // namespace HMF
@@ -5,8 +5,10 @@
 
 #include "hwtest.h"
 #include "hal/backend/ADCBackend.h"
+#include "hal/backend/HICANNBackend.h"
 #include "hal/Handle/ADCHw.h"
 #include "hal/HICANN/FGControl.h"
+#include "hal/HICANN/HICANNConfig.h"
 
 #include <cmath>
 #include <ctime>
@@ -251,6 +253,56 @@ TEST_F(HICANNAnalogTest, CheckSomeValuesHWTest) {
 	);
 }
 
+//floating gates programmed by HICANNConfig have to match set_fg_values
+TEST_F(HICANNAnalogTest, HICANNConfigFGHWTest) {
+	HICANN::init(h, false);
+
+	FGBlockOnHICANN block {Enum{0}};
+	NeuronOnHICANN nrn;
+	std::array<HICANN::neuron_parameter, 3> const params = {{
+		HICANN::neuron_parameter::I_gl,
+		HICANN::neuron_parameter::I_intbbx,
+		HICANN::neuron_parameter::E_l}};
+
+	HICANN::HICANNConfig config;
+	config.floating_gates.setNeuron(nrn, params[0], 600);
+	config.floating_gates.setNeuron(nrn, params[1], 300);
+	config.floating_gates.setNeuron(nrn, params[2], 450);
+
+	//configure ADC
+	HMF::ADC::Config conf = HMF::ADC::Config(980, chan0, trig);
+	HMF::ADC::config(adc, conf);
+
+	auto const measure = [this, &nrn, &params, &block]() {
+		HICANN::Analog aout;
+		aout.set_fg_left(AnalogOnHICANN(0));
+		aout.set_none(AnalogOnHICANN(1));
+		HICANN::set_analog(h, aout);
+
+		std::array<double, 3> voltages;
+		for (size_t i = 0; i < params.size(); i++) {
+			HICANN::set_fg_cell(h, nrn, params[i]);
+			HICANN::flush(h);
+			HMF::ADC::trigger_now(adc);
+			voltages[i] = cal.get_voltage(VecInfo(HMF::ADC::get_trace(adc)).mean());
+		}
+		return voltages;
+	};
+
+	HICANN::set_fg_config(h, block, config.fg_config[block.toEnum()]);
+	HICANN::set_fg_values(h, config.floating_gates);
+	auto const expected = measure();
+
+	//program different values in between
+	HICANN::set_fg_values(h, HICANN::FGControl());
+
+	HICANN::apply(h, config);
+	auto const actual = measure();
+
+	for (size_t i = 0; i < params.size(); i++)
+		EXPECT_NEAR(expected[i], actual[i], 0.05) << "parameter " << params[i];
+}
+
 TEST_F(HICANNAnalogTest, DISABLED_FGResponseCurveHWTest) {
 	HICANN::init(h, false);
 
@@ -174,6 +174,69 @@ TYPED_TEST(HICANNBackendTest, DISABLED_SynapseWeightHWTest) {
 	//~ RET->getSC(HCSYN::SYNAPSE_BOTTOM).print_weight();
 }
 
+TYPED_TEST(HICANNBackendTest, SynapseWeightArrayHWTest) {
+	HICANN::init(this->h, false); //initialize HICANN to be able to do the test in the first place
+
+	//generate test data, different for each row and controller
+	std::vector<HICANN::WeightRow> pattern(SynapseRowOnHICANN::size);
+	HICANN::WeightRow row;
+	std::generate(row.begin(), row.end(), IncrementingSequence<HICANN::SynapseWeight>(0xf));
+	for (auto& p : pattern) {
+		std::rotate(row.begin(), row.begin()+1, row.end());
+		p = row;
+	}
+
+	HICANN::set_weights(this->h, pattern);
+
+	for (auto s : iter_all<SynapseRowOnHICANN>())
+		EXPECT_EQ(pattern[s.toEnum()], HICANN::get_weights_row(this->h, s));
+
+	EXPECT_THROW(HICANN::set_weights(this->h, std::vector<HICANN::WeightRow>(1)), std::invalid_argument);
+
+	//read back the whole array at once
+	EXPECT_EQ(pattern, HICANN::get_weights(this->h));
+	EXPECT_TRUE(HICANN::verify_weights(this->h, pattern).empty());
+
+	//only differing rows are reported, with the actual weights
+	auto expected = pattern;
+	SynapseRowOnHICANN const top_row(Enum(3)), bottom_row(Enum(400));
+	expected[top_row.toEnum()][0] = HICANN::SynapseWeight((pattern[top_row.toEnum()][0].value() + 1) % 16);
+	expected[bottom_row.toEnum()][255] = HICANN::SynapseWeight((pattern[bottom_row.toEnum()][255].value() + 1) % 16);
+	auto const mismatches = HICANN::verify_weights(this->h, expected);
+	ASSERT_EQ(2, mismatches.size());
+	EXPECT_EQ(top_row, mismatches[0].first);
+	EXPECT_EQ(pattern[top_row.toEnum()], mismatches[0].second);
+	EXPECT_EQ(bottom_row, mismatches[1].first);
+	EXPECT_EQ(pattern[bottom_row.toEnum()], mismatches[1].second);
+}
+
+TYPED_TEST(HICANNBackendTest, HICANNConfigHWTest) {
+	HICANN::init(this->h, false); //initialize HICANN to be able to do the test in the first place
+
+	HICANN::HICANNConfig config;
+	HICANN::WeightRow row;
+	std::generate(row.begin(), row.end(), IncrementingSequence<HICANN::SynapseWeight>(0xf));
+	for (auto& w : config.weights) {
+		std::rotate(row.begin(), row.begin()+1, row.end());
+		w = row;
+	}
+	HICANN::CrossbarRow switches;
+	switches[1] = true;
+	config.crossbar.set_row(HLineOnHICANN(5), left, switches);
+	config.merger_tree.set_one_on_one();
+	config.phase = HICANN::Phase(0xa5);
+
+	HICANN::apply(this->h, config);
+
+	EXPECT_EQ(config.weights, HICANN::get_weights(this->h));
+	EXPECT_EQ(switches, HICANN::get_crossbar_switch_row(this->h, HLineOnHICANN(5), left));
+	EXPECT_EQ(config.merger_tree, HICANN::get_merger_tree(this->h));
+	EXPECT_EQ(config.phase, HICANN::get_phase(this->h));
+
+	config.weights.pop_back();
+	EXPECT_THROW(HICANN::apply(this->h, config), std::invalid_argument);
+}
+
 TYPED_TEST(HICANNBackendTest, DISABLED_SynapseDecoderHWTest) {
 	HICANN::init(this->h, false); //initialize HICANN to be able to do the test in the first place
 
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "hal/backend/BusyWait.h"
+
+using namespace HMF::HICANN;
+
+namespace HMF {
+
+TEST(BusyWait, WaitsUntilIdle)
+{
+	reset_busy_wait_counters();
+
+	size_t polls = 0;
+	busy_wait(WaitingController::synapse_array, [&polls]() { return ++polls < 100; });
+	EXPECT_EQ(100, polls);
+
+	// not busy at all
+	busy_wait(WaitingController::synapse_array, []() { return false; });
+
+	auto const counters = busy_wait_counters(WaitingController::synapse_array);
+	EXPECT_EQ(2, counters.waits);
+	EXPECT_EQ(101, counters.polls);
+	EXPECT_EQ(0, counters.timeouts);
+	EXPECT_LT(0, counters.wait_time.count());
+
+	// accounted per controller
+	EXPECT_EQ(0, busy_wait_counters(WaitingController::synapse_driver).waits);
+}
+
+TEST(BusyWait, Timeout)
+{
+	reset_busy_wait_counters();
+	auto const previous = busy_wait_timeout(WaitingController::floating_gate);
+	EXPECT_EQ(std::chrono::seconds(10), previous);
+
+	set_busy_wait_timeout(WaitingController::floating_gate, std::chrono::milliseconds(20));
+	auto const start = std::chrono::steady_clock::now();
+	try {
+		busy_wait(WaitingController::floating_gate, []() { return true; });
+		FAIL() << "no timeout";
+	} catch (BusyWaitTimeout const& e) {
+		EXPECT_EQ(WaitingController::floating_gate, e.controller());
+		EXPECT_LE(std::chrono::milliseconds(20), e.waited());
+	}
+	// backs off instead of spinning, but does not oversleep the deadline
+	EXPECT_GT(std::chrono::milliseconds(500), std::chrono::steady_clock::now() - start);
+
+	auto const counters = busy_wait_counters(WaitingController::floating_gate);
+	EXPECT_EQ(1, counters.timeouts);
+	EXPECT_GT(20000, counters.polls);
+
+	set_busy_wait_timeout(WaitingController::floating_gate, previous);
+	EXPECT_THROW(
+		set_busy_wait_timeout(WaitingController::floating_gate, std::chrono::seconds(0)),
+		std::invalid_argument);
+}
+
+} // namespace HMF
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "hal/backend/CommandScheduler.h"
+
+using namespace HMF::HICANN;
+
+namespace HMF {
+
+namespace {
+
+/// Controller staying busy for a fixed number of polls after each blocking command.
+struct MockController
+{
+	MockController(std::string const& name, std::vector<std::string>& log) :
+		name(name), log(log), busy_for(0), polls(0) {}
+
+	BlockingCommand write(std::string const& what)
+	{
+		return BlockingCommand{[this, what]() { log.push_back(name + what); }, {}};
+	}
+
+	BlockingCommand flush(size_t const polls_until_done)
+	{
+		return BlockingCommand{
+			[this, polls_until_done]() {
+				EXPECT_EQ(0, busy_for) << "issued while busy";
+				log.push_back(name + "flush");
+				busy_for = polls_until_done;
+			},
+			[this]() {
+				++polls;
+				if (busy_for == 0)
+					return false;
+				--busy_for;
+				return true;
+			}};
+	}
+
+	std::string name;
+	std::vector<std::string>& log;
+	size_t busy_for;
+	size_t polls;
+};
+
+} // namespace
+
+TEST(CommandScheduler, Interleave)
+{
+	std::vector<std::string> log;
+	MockController a("a", log), b("b", log);
+
+	std::vector<BlockingCommandQueue> queues(2);
+	queues[0] = {a.write("0"), a.flush(10), a.write("1"), a.flush(0)};
+	queues[1] = {b.write("0"), b.flush(0), b.write("1"), b.write("2"), b.flush(1)};
+
+	auto const statistics = apply(queues);
+
+	// b is not held up by the busy controller of a
+	std::vector<std::string> const expected = {
+		"a0", "aflush", "b0", "bflush", "b1", "b2", "bflush", "a1", "aflush"};
+	EXPECT_EQ(expected, log);
+
+	EXPECT_EQ(9, statistics.commands);
+	EXPECT_EQ(4, statistics.blocking_commands);
+	EXPECT_EQ(11, statistics.busy_polls);
+	// each blocking command is polled until not busy anymore
+	EXPECT_EQ(10 + 1 + 1, a.polls);
+	EXPECT_EQ(1 + 1 + 1, b.polls);
+	EXPECT_EQ(0, a.busy_for);
+	EXPECT_EQ(0, b.busy_for);
+}
+
+TEST(CommandScheduler, Empty)
+{
+	std::vector<std::string> log;
+	MockController a("a", log);
+
+	EXPECT_EQ(0, apply({}).commands);
+
+	std::vector<BlockingCommandQueue> queues(3);
+	queues[1] = {a.write("0"), a.write("1")};
+	auto const statistics = apply(queues);
+	EXPECT_EQ(2, statistics.commands);
+	EXPECT_EQ(0, statistics.blocking_commands);
+	EXPECT_EQ(0, statistics.busy_polls);
+	EXPECT_EQ((std::vector<std::string>{"a0", "a1"}), log);
+}
+
+TEST(CommandScheduler, Yield)
+{
+	auto const waits = busy_wait_counters(WaitingController::command_queue).waits;
+	std::vector<std::string> log;
+	MockController a("a", log), b("b", log);
+
+	BlockingCommand const step = BlockingCommand::yielding(b.write("0").issue);
+
+	std::vector<BlockingCommandQueue> queues(2);
+	queues[0] = {a.write("0"), a.flush(0), a.write("1"), a.flush(0), a.write("2")};
+	queues[1] = {step, step, b.write("1")};
+
+	auto const statistics = apply(queues);
+
+	// each step of b only waits for one round of a
+	std::vector<std::string> const expected = {
+		"a0", "aflush", "b0", "a1", "aflush", "b0", "a2", "b1"};
+	EXPECT_EQ(expected, log);
+	EXPECT_EQ(8, statistics.commands);
+	// yielding commands neither block nor wait, only the flushes of a are accounted
+	EXPECT_EQ(2, statistics.blocking_commands);
+	EXPECT_EQ(0, statistics.busy_polls);
+	EXPECT_EQ(2, busy_wait_counters(WaitingController::command_queue).waits - waits);
+}
+
+TEST(CommandScheduler, Timeout)
+{
+	auto const previous = busy_wait_timeout(WaitingController::command_queue);
+	set_busy_wait_timeout(WaitingController::command_queue, std::chrono::milliseconds(10));
+
+	std::vector<std::string> log;
+	MockController a("a", log), b("b", log);
+
+	std::vector<BlockingCommandQueue> queues(2);
+	queues[0] = {a.flush(size_t(-1)), a.write("0")};
+	queues[1] = {b.flush(1), b.write("0")};
+	EXPECT_THROW(apply(queues), BusyWaitTimeout);
+	EXPECT_EQ((std::vector<std::string>{"aflush", "bflush", "b0"}), log);
+
+	set_busy_wait_timeout(WaitingController::command_queue, previous);
+}
+
+} // namespace HMF
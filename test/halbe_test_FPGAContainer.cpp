@@ -3,8 +3,13 @@
 #include "hal/Coordinate/HMFGeometry.h"
 #include "hal/Coordinate/iter_all.h"
 #include "hal/FPGA/PulseAddress.h"
+#include "hal/FPGAContainer.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
 
 using namespace HMF::Coordinate;
 
@@ -230,5 +235,193 @@ TEST(PulseAddress, matches)
 	}
 }
 
+TEST(PulseEventContainer, SortsAlmostSortedEvents)
+{
+	std::mt19937 rng(42);
+	for (size_t max_delay : {1, 100, 1 << 15, 1 << 20}) {
+		std::uniform_int_distribution<PulseEvent::spiketime_t> delay(0, max_delay - 1);
+		PulseEventContainer::container_type events;
+		for (PulseEvent::spiketime_t time = 0; events.size() < 50000; time += rng() % 4) {
+			events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), time + delay(rng)));
+		}
+
+		auto expected = events;
+		std::sort(expected.begin(), expected.end());
+
+		PulseEventContainer const container(std::move(events), true);
+		EXPECT_EQ(expected, container.data()) << "max delay " << max_delay;
+	}
+}
+
+TEST(PulseEventContainer, MergesLinks)
+{
+	std::mt19937 rng(42);
+	std::vector<PulseEventContainer::container_type> per_link(8);
+	PulseEventContainer::container_type expected;
+	for (size_t link = 0; link < per_link.size(); ++link) {
+		for (size_t ii = 0; ii < 1000 * link; ++ii) {
+			per_link[link].push_back(
+			    PulseEvent(PulseAddress((link << 6) | (rng() & 0x3f)), rng() % 100000));
+		}
+		// first link is sorted, the others are merged after sorting
+		if (link == 0) {
+			std::sort(per_link[link].begin(), per_link[link].end());
+		}
+		expected.insert(expected.end(), per_link[link].begin(), per_link[link].end());
+	}
+	std::sort(expected.begin(), expected.end());
+
+	PulseEventContainer const container(per_link);
+	EXPECT_EQ(expected, container.data());
+
+	EXPECT_EQ(0, PulseEventContainer(std::vector<PulseEventContainer::container_type>()).size());
+}
+
+TEST(PulseEventContainer, MergesContainers)
+{
+	std::mt19937 rng(42);
+	std::vector<PulseEventContainer> containers;
+	PulseEventContainer::container_type expected;
+	for (size_t fpga = 0; fpga < 4; ++fpga) {
+		PulseEventContainer::container_type events;
+		for (size_t ii = 0; ii < 2000; ++ii) {
+			events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), rng() % 100000));
+		}
+		expected.insert(expected.end(), events.begin(), events.end());
+		containers.push_back(PulseEventContainer(std::move(events)));
+	}
+	std::sort(expected.begin(), expected.end());
+
+	PulseEventContainer const merged(containers);
+	EXPECT_EQ(expected, merged.data());
+
+	std::vector<PulseEventContainer const*> pointers;
+	for (auto const& container : containers) {
+		pointers.push_back(&container);
+	}
+	EXPECT_EQ(expected, PulseEventContainer(pointers).data());
+}
+
+TEST(PulseEventContainer, InsertRange)
+{
+	std::mt19937 rng(42);
+	PulseEventContainer container;
+	PulseEventContainer expected;
+	for (size_t batch = 0; batch < 10; ++batch) {
+		PulseEventContainer::container_type events;
+		for (size_t ii = 0; ii < 500; ++ii) {
+			events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), rng() % 10000));
+			expected.insert_sorted(events.back());
+		}
+		if (batch % 2) {
+			container.insert_range(events);
+		} else {
+			container.insert_range(std::move(events));
+		}
+		EXPECT_TRUE(std::is_sorted(container.data().begin(), container.data().end()));
+	}
+	EXPECT_EQ(expected.data(), container.data());
+
+	// batch after all contained events
+	container.insert_range(PulseEventContainer::container_type(
+		1, PulseEvent(PulseAddress(1), 20000)));
+	EXPECT_EQ(20000, container.data().back().getTime());
+	container.insert_range(PulseEventContainer::container_type());
+	EXPECT_EQ(expected.size() + 1, container.size());
+
+	// own events
+	container.insert_range(container.data());
+	EXPECT_EQ(2 * (expected.size() + 1), container.size());
+	EXPECT_TRUE(std::is_sorted(container.data().begin(), container.data().end()));
+}
+
+TEST(PulseEventContainer, Merge)
+{
+	std::mt19937 rng(42);
+	PulseEventContainer::container_type a, b;
+	for (size_t ii = 0; ii < 1000; ++ii) {
+		a.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), rng() % 10000));
+		b.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), rng() % 10000));
+	}
+	PulseEventContainer::container_type expected(a);
+	expected.insert(expected.end(), b.begin(), b.end());
+	std::sort(expected.begin(), expected.end());
+
+	PulseEventContainer container(a);
+	container.merge(PulseEventContainer(b));
+	EXPECT_EQ(expected, container.data());
+
+	PulseEventContainer twice(a);
+	twice.merge(twice);
+	EXPECT_EQ(2 * a.size(), twice.size());
+	EXPECT_TRUE(std::is_sorted(twice.data().begin(), twice.data().end()));
+}
+
+TEST(PulseEventContainer, TimeRange)
+{
+	std::mt19937 rng(42);
+	PulseEventContainer::container_type events;
+	for (size_t ii = 0; ii < 5000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), rng() % 10000));
+	}
+	PulseEventContainer const container(events);
+
+	for (size_t trial = 0; trial < 100; ++trial) {
+		PulseEvent::spiketime_t const t_begin = rng() % 11000;
+		PulseEvent::spiketime_t const t_end = t_begin + rng() % 2000;
+		PulseEventContainer::container_type expected;
+		std::copy_if(
+			container.data().begin(), container.data().end(), std::back_inserter(expected),
+			[t_begin, t_end](PulseEvent const& event) {
+				return event.getTime() >= t_begin && event.getTime() < t_end;
+			});
+		auto const range = container.time_range(t_begin, t_end);
+		EXPECT_EQ(expected, PulseEventContainer::container_type(range.first, range.second));
+	}
+	auto const empty = container.time_range(500, 100);
+	EXPECT_EQ(empty.first, empty.second);
+}
+
+TEST(PulseEventContainer, LabelIndex)
+{
+	std::mt19937 rng(42);
+	PulseEventContainer::container_type events;
+	for (size_t ii = 0; ii < 5000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() % 100), rng() % 10000));
+	}
+	PulseEventContainer container(events);
+
+	auto const check = [&container](PulseAddress::label_t const label) {
+		std::vector<size_t> expected;
+		std::vector<PulseEvent::spiketime_t> expected_times;
+		for (size_t ii = 0; ii < container.size(); ++ii) {
+			if (container[ii].getLabel() == label) {
+				expected.push_back(ii);
+				expected_times.push_back(container[ii].getTime());
+			}
+		}
+		auto const positions = container.positions_of(label);
+		EXPECT_EQ(expected, std::vector<size_t>(positions.first, positions.second));
+		EXPECT_EQ(expected_times, container.times_of(label));
+	};
+
+	for (PulseAddress::label_t label : {0, 42, 99, 100}) {
+		check(label);
+	}
+	EXPECT_THROW(container.positions_of(PulseAddress::num_labels), std::out_of_range);
+
+	// index is rebuilt after modifications
+	container.insert_sorted(PulseEvent(PulseAddress(42), 5000));
+	check(42);
+	container.append(PulseEvent(PulseAddress(100), 20000));
+	check(100);
+	container.insert_range(PulseEventContainer::container_type(3, PulseEvent(PulseAddress(99), 0)));
+	check(99);
+	container.merge(PulseEventContainer(events));
+	check(42);
+	container.clear();
+	check(42);
+}
+
 } // end namespace FPGA
 } // end namespace HMF
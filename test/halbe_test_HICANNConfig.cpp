@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include "hal/HICANN/HICANNConfig.h"
+
+using namespace HMF::Coordinate;
+using namespace HMF::HICANN;
+
+namespace HMF {
+
+TEST(HICANNConfig, Defaults)
+{
+	HICANNConfig const config;
+	EXPECT_EQ(SynapseDriverOnHICANN::size, config.decoders.size());
+	EXPECT_EQ(SynapseRowOnHICANN::size, config.weights.size());
+	EXPECT_EQ(config, HICANNConfig());
+}
+
+TEST(HICANNConfig, Serialization)
+{
+	HICANNConfig config;
+	CrossbarRow switches;
+	switches[2] = true;
+	config.crossbar.set_row(HLineOnHICANN(10), right, switches);
+	config.synapse_drivers[17].set_l1();
+	config.decoders[17][0][3] = SynapseDecoder(5);
+	config.weights[400][255] = SynapseWeight(15);
+	config.merger_tree.set_one_on_one();
+	config.phase = Phase(0x5);
+	config.floating_gates.setNeuron(NeuronOnHICANN(Enum(3)), neuron_parameter::E_l, 300);
+	EXPECT_NE(config, HICANNConfig());
+
+	std::stringstream stream;
+	{
+		boost::archive::binary_oarchive oa(stream);
+		oa << config;
+	}
+
+	HICANNConfig loaded;
+	{
+		boost::archive::binary_iarchive ia(stream);
+		ia >> loaded;
+	}
+	EXPECT_EQ(config, loaded);
+	EXPECT_TRUE(loaded.crossbar.get_row(HLineOnHICANN(10), right)[2]);
+	EXPECT_EQ(SynapseWeight(15), loaded.weights[400][255]);
+}
+
+} // namespace HMF
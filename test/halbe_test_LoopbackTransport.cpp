@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "hal/backend/FPGABackend.h"
+#include "hal/backend/LoopbackTransport.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+PulseEvent::spiketime_t const runtime = 1000000;
+
+PulseEventContainer generate_events()
+{
+	std::mt19937 rng(1234);
+	PulseEventContainer::container_type events;
+	for (size_t ii = 0; ii < 20000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), 80 + rng() % (runtime - 1000)));
+	}
+	return PulseEventContainer(std::move(events));
+}
+
+/// Events as recorded by the trace, which only sees 12 bit labels.
+PulseEventContainer::container_type looped_back(PulseEventContainer const& events)
+{
+	PulseEventContainer::container_type expected;
+	for (auto const& event : events.data()) {
+		expected.push_back(PulseEvent(PulseAddress(event.getLabel() & 0xfff), event.getTime()));
+	}
+	std::sort(expected.begin(), expected.end());
+	return expected;
+}
+
+} // namespace
+
+TEST(LoopbackTransport, RoundTrip)
+{
+	auto const events = generate_events();
+
+	LoopbackTransport::Config config;
+	config.reorder_probability = 0.1;
+	config.jitter = std::chrono::microseconds(5);
+	LoopbackTransport transport(config);
+
+	write_playback_pulses(transport, events, runtime);
+	EXPECT_EQ(events.size(), transport.uploaded_pulses());
+	EXPECT_EQ(0, transport.lost_pulses());
+	// two pulses per word, overflow indicators and end-of-trace marker
+	EXPECT_LT(events.size() / 2 / LoopbackTransport::max_packet_words, transport.trace_packets());
+
+	auto const trace =
+		read_trace_pulses(transport, Coordinate::FPGAGlobal(), runtime, TraceEventFilter());
+	EXPECT_EQ(0, trace.dropped_events);
+	EXPECT_EQ(0, transport.pending_packets());
+	EXPECT_EQ(looped_back(events), PulseEventContainer(trace).data());
+}
+
+TEST(LoopbackTransport, Loss)
+{
+	auto const events = generate_events();
+
+	LoopbackTransport::Config config;
+	config.drop_probability = 0.25;
+	config.seed = 42;
+	LoopbackTransport transport(config);
+
+	write_playback_pulses(transport, events, runtime);
+	EXPECT_LT(events.size() / 5, transport.lost_pulses());
+	EXPECT_GT(events.size() / 3, transport.lost_pulses());
+
+	TraceEventFilter filter;
+	filter.drop_background_events();
+	auto const trace = read_trace_pulses(transport, Coordinate::FPGAGlobal(), runtime, filter);
+	auto const expected = looped_back(events);
+	size_t const background = std::count_if(
+		expected.begin(), expected.end(),
+		[](PulseEvent const& event) { return (event.getLabel() & 0x3f) == 0; });
+	EXPECT_GE(background, trace.dropped_events);
+	EXPECT_EQ(events.size(), trace.events.size() + trace.dropped_events + transport.lost_pulses());
+	for (auto const& event : trace.events) {
+		EXPECT_TRUE(std::binary_search(expected.begin(), expected.end(), event));
+	}
+
+	config.drop_probability = 1.5;
+	EXPECT_THROW(LoopbackTransport{config}, std::invalid_argument);
+}
+
+TEST(LoopbackTransport, Realtime)
+{
+	LoopbackTransport::Config config;
+	config.realtime = true;
+	config.latency = std::chrono::milliseconds(20);
+	LoopbackTransport transport(config);
+
+	// 4 ms experiment
+	auto const start = LoopbackTransport::clock_type::now();
+	write_playback_pulses(transport, generate_events(), runtime);
+	sctrltp::packet packet;
+	EXPECT_FALSE(transport.receive(packet));
+
+	auto const trace =
+		read_trace_pulses(transport, Coordinate::FPGAGlobal(), runtime, TraceEventFilter());
+	EXPECT_LE(
+		std::chrono::microseconds(runtime / DNC_frequency_in_MHz) + config.latency,
+		LoopbackTransport::clock_type::now() - start);
+	EXPECT_EQ(20000, trace.events.size());
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "hal/FPGA/PlaybackAnalyzer.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+/// Overloaded sequence: about one pulse per FPGA cycle on average.
+PulseEventContainer generate_dense_events()
+{
+	std::mt19937 rng(1234);
+	PulseEventContainer::container_type events;
+	for (size_t ii = 0; ii < 10000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), 80 + rng() % 20000));
+	}
+	return PulseEventContainer(std::move(events));
+}
+
+} // namespace
+
+TEST(PlaybackAnalyzer, Analyze)
+{
+	PlaybackAnalyzer const analyzer(ReleaseLimit(40, 2), 10, 8);
+
+	// nominal release at FPGA cycles 1, 2, 2, 2, 2, 51, released at 1, 2, 3, 4, (dropped), 51
+	PulseEventContainer::container_type const events = {
+		PulseEvent(PulseAddress(0x001), 82),  PulseEvent(PulseAddress(0x201), 84),
+		PulseEvent(PulseAddress(0x201), 84),  PulseEvent(PulseAddress(0x1201), 85),
+		PulseEvent(PulseAddress(0x1201), 85), PulseEvent(PulseAddress(0x001), 182)};
+	auto const load = analyzer.analyze(PulseEventContainer(events, true));
+
+	EXPECT_EQ(6, load.pulses);
+	EXPECT_EQ(5, load.peak_pulses);
+	EXPECT_EQ(82, load.peak_time);
+	EXPECT_DOUBLE_EQ(0.5, load.peak_utilization());
+	ASSERT_EQ(PlaybackLoad::num_links, load.pulses_per_link.size());
+	EXPECT_EQ(256, PlaybackLoad::num_links);
+	EXPECT_EQ(2, load.pulses_per_link[0]);
+	// links of different DNCs are counted separately
+	EXPECT_EQ(2, load.pulses_per_link[PlaybackLoad::link(0x201)]);
+	EXPECT_EQ(2, load.pulses_per_link[PlaybackLoad::link(0x1201)]);
+	EXPECT_NE(PlaybackLoad::link(0x201), PlaybackLoad::link(0x1201));
+	EXPECT_EQ(48, load.memory_bytes);
+	EXPECT_EQ(2, load.delayed_pulses);
+	EXPECT_EQ(2, load.max_release_delay);
+	EXPECT_EQ(1, load.dropped_pulses);
+
+	auto const dropped = analyzer.dropped(PulseEventContainer(events, true));
+	ASSERT_EQ(1, dropped.size());
+	EXPECT_EQ(events[4], dropped[0]);
+
+	EXPECT_THROW(PlaybackAnalyzer(ReleaseLimit(), 0), std::invalid_argument);
+	EXPECT_THROW(
+		analyzer.analyze(PulseEventContainer({PulseEvent(PulseAddress(1), 79)}, true)),
+		std::runtime_error);
+}
+
+TEST(PlaybackAnalyzer, MatchesReleaseLimit)
+{
+	ReleaseLimit const limit;
+	PlaybackAnalyzer const analyzer(limit);
+	auto const events = generate_dense_events();
+
+	size_t dropped_events = 0;
+	auto const released = limit.apply(events, dropped_events);
+	ASSERT_LT(0, dropped_events);
+
+	auto const load = analyzer.analyze(events);
+	EXPECT_EQ(dropped_events, load.dropped_pulses);
+	EXPECT_EQ(events.size(), load.pulses);
+	EXPECT_EQ(
+		events.size(),
+		std::accumulate(load.pulses_per_link.begin(), load.pulses_per_link.end(), size_t(0)));
+	EXPECT_EQ(dropped_events, analyzer.dropped(events).size());
+	EXPECT_EQ(released.size() + dropped_events, events.size());
+}
+
+TEST(PlaybackAnalyzer, Shape)
+{
+	ReleaseLimit const limit;
+	PlaybackAnalyzer const analyzer(limit);
+	auto const events = generate_dense_events();
+
+	auto const shaped = analyzer.shape(events, 1000000);
+	EXPECT_EQ(0, shaped.dropped.size());
+	EXPECT_EQ(events.size(), shaped.events.size());
+	EXPECT_LT(0, shaped.moved);
+	EXPECT_LT(0, shaped.max_shift);
+
+	size_t dropped_events = 0;
+	auto const released = limit.apply(shaped.events, dropped_events);
+	EXPECT_EQ(0, dropped_events);
+	EXPECT_EQ(shaped.events.data(), released.data());
+	EXPECT_EQ(0, analyzer.analyze(shaped.events).dropped_pulses);
+
+	// without budget, shaping drops exactly the pulses dropped on release
+	auto const unshaped = analyzer.shape(events, 0);
+	EXPECT_EQ(0, unshaped.moved);
+	EXPECT_EQ(analyzer.dropped(events).data(), unshaped.dropped.data());
+	EXPECT_EQ(limit.apply(events, dropped_events).data(), unshaped.events.data());
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <unistd.h>
+#include <random>
+#include <stdexcept>
+
+#include "hal/FPGA/PlaybackProgram.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+PulseEventContainer generate_events()
+{
+	std::mt19937 rng(1234);
+	PulseEventContainer::container_type events;
+	for (size_t ii = 0; ii < 10000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), 80 + rng() % 1000000));
+	}
+	return PulseEventContainer(std::move(events));
+}
+
+} // namespace
+
+TEST(PlaybackProgram, Compile)
+{
+	auto const events = generate_events();
+	PlaybackProgram const program(events, 2000000, 40);
+
+	PlaybackPulseEncoder encoder;
+	encoder.encode(events, 2000000, 40);
+	EXPECT_EQ(encoder.pulses(), program.pulses());
+	EXPECT_EQ(encoder.end_of_experiment_timestamp(), program.end_of_experiment_timestamp());
+	EXPECT_EQ(2000000, program.runtime());
+	EXPECT_EQ(40, program.fpga_hicann_delay());
+
+	EXPECT_EQ(events.data(), program.events().data());
+
+	EXPECT_THROW(PlaybackProgram(events, 1000, 40), std::runtime_error);
+}
+
+TEST(PlaybackProgram, SaveLoad)
+{
+	PlaybackProgram const program(generate_events(), 2000000, 40);
+
+	char filename[] = "/tmp/halbe_test_PlaybackProgramXXXXXX";
+	int const fd = mkstemp(filename);
+	ASSERT_NE(-1, fd);
+	close(fd);
+
+	program.save(filename);
+	EXPECT_EQ(program, PlaybackProgram::load(filename));
+	std::remove(filename);
+
+	EXPECT_THROW(PlaybackProgram::load(filename), std::runtime_error);
+}
+
+} // namespace FPGA
+} // namespace HMF
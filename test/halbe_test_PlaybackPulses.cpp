@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+
+#include "hal/FPGA/PlaybackPulses.h"
+
+namespace HMF {
+namespace FPGA {
+
+TEST(PlaybackPulseEncoder, Encode)
+{
+	std::mt19937 rng(1234);
+	PulseEventContainer::container_type events;
+	for (size_t ii = 0; ii < 10000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), 80 + rng() % 1000000));
+	}
+	PulseEventContainer const container(std::move(events));
+
+	PlaybackPulseEncoder encoder;
+	encoder.encode(container, 2000000, 40);
+	ASSERT_EQ(container.size(), encoder.pulses().size());
+	EXPECT_EQ(1000000, encoder.end_of_experiment_timestamp());
+
+	for (size_t ii = 0; ii < container.size(); ++ii) {
+		auto const& pulse = encoder.pulses()[ii];
+		EXPECT_EQ(container[ii].getTime() / 2 - 40, pulse.fpga_time);
+		EXPECT_EQ(container[ii].getTime(), pulse.hicann_time);
+		EXPECT_EQ(container[ii].getLabel(), pulse.label);
+	}
+
+	// buffer is reused
+	encoder.encode(PulseEventContainer(), 1, 40);
+	EXPECT_TRUE(encoder.pulses().empty());
+	EXPECT_EQ(1, encoder.end_of_experiment_timestamp());
+}
+
+TEST(PlaybackPulseEncoder, Validation)
+{
+	PulseEventContainer container;
+	container.append(PulseEvent(PulseAddress(1), 79));
+	container.append(PulseEvent(PulseAddress(2), 1000));
+
+	PlaybackPulseEncoder encoder;
+	EXPECT_THROW(encoder.encode(container, 1000, 40), std::runtime_error);
+	EXPECT_NO_THROW(encoder.encode(container, 1000, 39));
+	// last pulse is released at 1000 / 2 - 39
+	EXPECT_NO_THROW(encoder.encode(container, 2 * 461 - 1, 39));
+	EXPECT_THROW(encoder.encode(container, 2 * 460 - 1, 39), std::runtime_error);
+
+	EXPECT_EQ(461, PlaybackPulseEncoder::validate(container, 2 * 461 - 1, 39));
+	EXPECT_THROW(PlaybackPulseEncoder::validate(container, 1000, 40), std::runtime_error);
+}
+
+} // namespace FPGA
+} // namespace HMF
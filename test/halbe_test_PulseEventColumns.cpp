@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include "hal/FPGA/PulseEventColumns.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+PulseEventContainer::container_type generate_events(size_t const size)
+{
+	std::mt19937_64 rng(1234);
+	PulseEventContainer::container_type events;
+	PulseEvent::spiketime_t time = 0;
+	for (size_t ii = 0; ii < size; ++ii) {
+		// almost sorted, with occasional large gaps
+		time += (ii % 3000 == 2999) ? (1ull << 33) : rng() % 100;
+		events.push_back(
+		    PulseEvent(PulseAddress(rng() & 0x3fff), time + rng() % (1 << 15)));
+	}
+	return events;
+}
+
+} // namespace
+
+TEST(PulseEventColumns, RoundTrip)
+{
+	auto const events = generate_events(10000);
+	for (auto const encoding :
+	     {PulseEventColumns::TimeEncoding::absolute, PulseEventColumns::TimeEncoding::delta}) {
+		PulseEventColumns const columns(AlmostSortedPulseEvents(events), encoding);
+		ASSERT_EQ(events.size(), columns.size());
+		EXPECT_EQ(events, columns.events());
+
+		for (size_t ii = 0; ii < events.size(); ii += 7) {
+			EXPECT_EQ(events[ii], columns[ii]);
+			EXPECT_EQ(events[ii].getLabel(), columns.label(ii));
+		}
+
+		PulseEventContainer::container_type copy(columns.begin(), columns.end());
+		EXPECT_EQ(events, copy);
+
+		auto it = columns.begin();
+		std::advance(it, 42);
+		EXPECT_EQ(events[42].getTime(), it->getTime());
+		EXPECT_EQ(events[42].getLabel(), it->getLabel());
+	}
+}
+
+TEST(PulseEventColumns, Columns)
+{
+	auto const events = generate_events(10000);
+	PulseEventColumns const absolute(events);
+	PulseEventColumns const delta(events, PulseEventColumns::TimeEncoding::delta);
+
+	ASSERT_EQ(events.size(), absolute.times().size());
+	EXPECT_EQ(events[42].getTime(), absolute.times()[42]);
+	EXPECT_THROW(delta.times(), std::logic_error);
+
+	PulseAddress::label_t const label = events[123].getLabel();
+	std::vector<PulseEvent::spiketime_t> expected;
+	for (auto const& event : events) {
+		if (event.getLabel() == label) {
+			expected.push_back(event.getTime());
+		}
+	}
+	EXPECT_EQ(expected, absolute.times_of(label));
+	EXPECT_EQ(expected, delta.times_of(label));
+}
+
+TEST(PulseEventColumns, FromContainer)
+{
+	PulseEventContainer const container(generate_events(5000));
+	PulseEventColumns const columns(container, PulseEventColumns::TimeEncoding::delta);
+	EXPECT_EQ(container.data(), columns.events());
+
+	PulseEventColumns empty;
+	EXPECT_TRUE(empty.empty());
+	EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(PulseEventColumns, Serialization)
+{
+	PulseEventColumns const columns(generate_events(5000), PulseEventColumns::TimeEncoding::delta);
+
+	std::stringstream stream;
+	{
+		boost::archive::binary_oarchive oa(stream);
+		oa << columns;
+	}
+
+	PulseEventColumns loaded;
+	{
+		boost::archive::binary_iarchive ia(stream);
+		ia >> loaded;
+	}
+	EXPECT_EQ(columns, loaded);
+	EXPECT_EQ(columns.events(), loaded.events());
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+
+#include "hal/FPGA/PulseEventPartition.h"
+
+namespace HMF {
+namespace FPGA {
+
+TEST(PulseEventPartition, Buckets)
+{
+	std::mt19937 rng(1234);
+	PulseEventContainer::container_type data;
+	for (size_t ii = 0; ii < 20000; ++ii) {
+		data.push_back(PulseEvent(PulseAddress(rng() & 0x3fff), rng() % 100000));
+	}
+	PulseEventContainer const events(std::move(data));
+
+	for (auto const prefix : {PulseEventPartition::Prefix::dnc, PulseEventPartition::Prefix::chip,
+	                          PulseEventPartition::Prefix::channel}) {
+		PulseEventPartition const partition(events, prefix);
+		EXPECT_EQ(prefix, partition.prefix());
+		EXPECT_EQ(events.size(), partition.data().size());
+		EXPECT_EQ(PulseAddress::num_labels >> PulseEventPartition::shift(prefix),
+		          partition.num_buckets());
+
+		PulseAddress::label_t const mask = ~((1u << PulseEventPartition::shift(prefix)) - 1) & 0x3fff;
+		for (size_t bucket = 0; bucket < partition.num_buckets(); ++bucket) {
+			PulseAddress const address = partition.address(bucket);
+			EXPECT_EQ(bucket, partition.bucket_of(address));
+			EXPECT_EQ(bucket, partition.bucket_of(PulseAddress(address.getLabel() | 0xc000)));
+
+			PulseEventContainer::container_type expected;
+			std::copy_if(
+				events.data().begin(), events.data().end(), std::back_inserter(expected),
+				[&address, mask](PulseEvent const& event) {
+					return (event.getLabel() & mask) == address.getLabel();
+				});
+			auto const span = partition[bucket];
+			ASSERT_EQ(expected.size(), partition.size(bucket));
+			EXPECT_TRUE(std::equal(span.first, span.second, expected.begin()));
+		}
+	}
+}
+
+TEST(PulseEventPartition, MatchesLinks)
+{
+	PulseEventContainer::container_type data;
+	for (size_t ii = 0; ii < 1000; ++ii) {
+		data.push_back(PulseEvent(PulseAddress(ii * 23 & 0x3fff), ii));
+	}
+	PulseEventPartition const partition(data, PulseEventPartition::Prefix::channel);
+
+	for (size_t bucket = 0; bucket < partition.num_buckets(); ++bucket) {
+		PulseAddress const address = partition.address(bucket);
+		auto const span = partition[bucket];
+		for (auto it = span.first; it != span.second; ++it) {
+			EXPECT_TRUE(it->matches(
+				address.getDncAddress(), address.getChipAddress(), address.getChannel()));
+		}
+		EXPECT_TRUE(std::is_sorted(span.first, span.second));
+	}
+}
+
+} // namespace FPGA
+} // namespace HMF
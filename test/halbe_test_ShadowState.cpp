@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "hal/backend/ShadowState.h"
+
+using namespace HMF::HICANN;
+using namespace HMF::Coordinate;
+
+namespace HMF {
+
+TEST(ShadowState, SkipsUnchanged)
+{
+	ShadowState shadow;
+	SynapseRowOnHICANN const row(Enum(42));
+	WeightRow weights;
+	weights[3] = SynapseWeight(7);
+
+	// nothing written yet
+	EXPECT_FALSE(shadow.unchanged(row, weights));
+	shadow.written(row, weights);
+	EXPECT_TRUE(shadow.unchanged(row, weights));
+	EXPECT_FALSE(shadow.unchanged(SynapseRowOnHICANN(Enum(43)), weights));
+
+	WeightRow changed = weights;
+	changed[255] = SynapseWeight(1);
+	EXPECT_FALSE(shadow.unchanged(row, changed));
+	shadow.written(row, changed);
+	EXPECT_FALSE(shadow.unchanged(row, weights));
+	EXPECT_TRUE(shadow.unchanged(row, changed));
+
+	EXPECT_EQ(2, shadow.counters().issued);
+	EXPECT_EQ(2, shadow.counters().skipped);
+	shadow.reset_counters();
+	EXPECT_EQ(0, shadow.counters().issued);
+	EXPECT_EQ(0, shadow.counters().skipped);
+}
+
+TEST(ShadowState, ContainerTypes)
+{
+	ShadowState shadow;
+
+	// crossbar rows are addressed by line and side
+	CrossbarRow switches;
+	switches[1] = true;
+	shadow.written(ShadowState::crossbar_row_t(HLineOnHICANN(3), left), switches);
+	EXPECT_TRUE(shadow.unchanged(ShadowState::crossbar_row_t(HLineOnHICANN(3), left), switches));
+	EXPECT_FALSE(shadow.unchanged(ShadowState::crossbar_row_t(HLineOnHICANN(3), right), switches));
+
+	// decoders are cached per synapse driver
+	SynapseDriverOnHICANN const drv(Enum(5));
+	shadow.written(drv, DecoderDoubleRow());
+	EXPECT_TRUE(shadow.unchanged(drv, DecoderDoubleRow()));
+
+	QuadOnHICANN const quad(Enum(2));
+	NeuronQuad nquad;
+	nquad.setVerticalInterconnect(X(1), true);
+	shadow.written(quad, nquad);
+	EXPECT_TRUE(shadow.unchanged(quad, nquad));
+	EXPECT_FALSE(shadow.unchanged(quad, NeuronQuad()));
+
+	SynapseSwitchRowOnHICANN const switch_row(Y(7), left);
+	shadow.written(switch_row, SynapseSwitchRow());
+	EXPECT_TRUE(shadow.unchanged(switch_row, SynapseSwitchRow()));
+
+	// the counters survive the invalidation
+	shadow.invalidate();
+	EXPECT_FALSE(shadow.unchanged(ShadowState::crossbar_row_t(HLineOnHICANN(3), left), switches));
+	EXPECT_FALSE(shadow.unchanged(drv, DecoderDoubleRow()));
+	EXPECT_FALSE(shadow.unchanged(quad, nquad));
+	EXPECT_FALSE(shadow.unchanged(switch_row, SynapseSwitchRow()));
+	EXPECT_EQ(4, shadow.counters().issued);
+	EXPECT_EQ(4, shadow.counters().skipped);
+}
+
+TEST(ShadowState, Forget)
+{
+	ShadowState shadow;
+	SynapseRowOnHICANN const row(Enum(42));
+	SynapseDriverOnHICANN const drv(Enum(21));
+	shadow.written(row, WeightRow());
+	shadow.written(SynapseRowOnHICANN(Enum(43)), WeightRow());
+	shadow.written(drv, DecoderDoubleRow());
+
+	// a write failing after forget() leaves no entry behind
+	shadow.forget(row, WeightRow());
+	EXPECT_FALSE(shadow.unchanged(row, WeightRow()));
+	EXPECT_TRUE(shadow.unchanged(SynapseRowOnHICANN(Enum(43)), WeightRow()));
+
+	// e.g. after starting STDP, decoders are kept
+	shadow.invalidate_weights();
+	EXPECT_FALSE(shadow.unchanged(SynapseRowOnHICANN(Enum(43)), WeightRow()));
+	EXPECT_TRUE(shadow.unchanged(drv, DecoderDoubleRow()));
+	EXPECT_EQ(3, shadow.counters().issued);
+}
+
+} // namespace HMF
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+#include "hal/FPGA/SpikeFile.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+/// Sorted events of 8 links, interleaved with a random delay of up to max_delay.
+PulseEventContainer::container_type generate_events(size_t const num_events)
+{
+	PulseEvent::spiketime_t const max_delay = 1 << 15;
+	std::mt19937 rng(1234);
+	std::vector<std::pair<PulseEvent::spiketime_t, PulseEvent> > arrivals;
+	std::vector<PulseEvent::spiketime_t> time(8, 0);
+	for (size_t ii = 0; ii < num_events; ++ii) {
+		size_t const link = ii % time.size();
+		time[link] += rng() % 256;
+		arrivals.emplace_back(
+			time[link] + rng() % max_delay,
+			PulseEvent(PulseAddress((link << 6) | (rng() & 0x3f)), time[link]));
+	}
+	std::stable_sort(
+		arrivals.begin(), arrivals.end(),
+		[](std::pair<PulseEvent::spiketime_t, PulseEvent> const& a,
+		   std::pair<PulseEvent::spiketime_t, PulseEvent> const& b) { return a.first < b.first; });
+
+	PulseEventContainer::container_type events;
+	for (auto const& arrival : arrivals)
+		events.push_back(arrival.second);
+	return events;
+}
+
+class SpikeFileTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		char filename[] = "/tmp/halbe_test_SpikeFileXXXXXX";
+		int const fd = mkstemp(filename);
+		ASSERT_NE(-1, fd);
+		close(fd);
+		m_filename = filename;
+	}
+
+	void TearDown() override { std::remove(m_filename.c_str()); }
+
+	std::string m_filename;
+};
+
+} // namespace
+
+TEST_F(SpikeFileTest, RoundTripAlmostSorted)
+{
+	auto const events = generate_events(20000);
+	SpikeFileWriter::write(m_filename, AlmostSortedPulseEvents(events, 42));
+
+	SpikeFile const file(m_filename);
+	EXPECT_EQ(SpikeFileHeader::current_version, file.version());
+	EXPECT_FALSE(file.is_sorted());
+	ASSERT_EQ(events.size(), file.size());
+	EXPECT_EQ(42, file.dropped_events());
+	EXPECT_EQ(events, file.almost_sorted_events().events);
+	EXPECT_EQ(PulseEventContainer(events).data(), file.container().data());
+}
+
+TEST_F(SpikeFileTest, RoundTripSorted)
+{
+	PulseEventContainer const events(generate_events(20000));
+	SpikeFileWriter::write(m_filename, events);
+
+	SpikeFile const file(m_filename);
+	EXPECT_TRUE(file.is_sorted());
+	EXPECT_EQ(0, file.dropped_events());
+	EXPECT_EQ(events.data(), file.container().data());
+}
+
+TEST_F(SpikeFileTest, Empty)
+{
+	SpikeFileWriter::write(m_filename, PulseEventContainer());
+
+	SpikeFile const file(m_filename);
+	EXPECT_EQ(0, file.size());
+	EXPECT_EQ(0, file.time_range(0, 1000).second);
+	EXPECT_TRUE(file.events(0, 1000).empty());
+}
+
+TEST_F(SpikeFileTest, TimeRange)
+{
+	auto const almost_sorted = generate_events(50000);
+	PulseEventContainer const sorted(almost_sorted);
+
+	for (bool const is_sorted : {false, true}) {
+		auto const& events = is_sorted ? sorted.data() : almost_sorted;
+		{
+			SpikeFileWriter writer(m_filename, 1000);
+			// streamed in chunks
+			for (size_t ii = 0; ii < events.size(); ii += 7777) {
+				writer.append(PulseEventContainer::container_type(
+					events.begin() + ii, events.begin() + std::min(ii + 7777, events.size())));
+			}
+			EXPECT_EQ(events.size(), writer.size());
+		}
+
+		SpikeFile const file(m_filename);
+		ASSERT_EQ(is_sorted, file.is_sorted());
+
+		std::mt19937 rng(1234);
+		auto const max_time = sorted.data().back().getTime();
+		for (size_t trial = 0; trial < 200; ++trial) {
+			PulseEvent::spiketime_t const t_begin = rng() % max_time;
+			PulseEvent::spiketime_t const t_end = t_begin + rng() % 100000;
+
+			PulseEventContainer::container_type expected;
+			for (auto const& event : events) {
+				if (event.getTime() >= t_begin && event.getTime() < t_end)
+					expected.push_back(event);
+			}
+			EXPECT_EQ(expected, file.events(t_begin, t_end));
+
+			auto const range = file.time_range(t_begin, t_end);
+			if (is_sorted) {
+				EXPECT_EQ(expected.size(), range.second - range.first);
+			} else {
+				// coarse, but never more than the blocks covered by the events
+				EXPECT_GE(range.second - range.first, expected.size());
+				EXPECT_EQ(0, range.first % 1000);
+			}
+		}
+	}
+}
+
+TEST_F(SpikeFileTest, Invalid)
+{
+	EXPECT_THROW(SpikeFile("/nonexistent/spikes"), std::runtime_error);
+	EXPECT_THROW(SpikeFileWriter(m_filename, 0), std::invalid_argument);
+
+	{
+		std::ofstream stream(m_filename);
+		stream << "no spike file";
+	}
+	EXPECT_THROW(SpikeFile file(m_filename), std::runtime_error);
+
+	SpikeFileWriter::write(m_filename, PulseEventContainer(generate_events(1000)));
+	ASSERT_EQ(0, truncate(m_filename.c_str(), 1000));
+	EXPECT_THROW(SpikeFile file(m_filename), std::runtime_error);
+}
+
+} // namespace FPGA
+} // namespace HMF
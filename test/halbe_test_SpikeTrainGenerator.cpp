@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "hal/FPGA/SpikeTrainGenerator.h"
+
+namespace HMF {
+namespace FPGA {
+
+TEST(SpikeTrainGenerator, Regular)
+{
+	SpikeTrainGenerator generator;
+	generator.add_regular({PulseAddress(1), PulseAddress(2)}, 100, 1000, 2000, 10);
+	EXPECT_EQ(2, generator.num_sources());
+
+	auto const spikes = generator.generate();
+	ASSERT_EQ(20, spikes.size());
+	for (size_t ii = 0; ii < spikes.size(); ++ii) {
+		EXPECT_EQ(1010 + (ii / 2) * 100, spikes[ii].getTime());
+		EXPECT_EQ(1 + ii % 2, spikes[ii].getLabel());
+	}
+
+	EXPECT_THROW(generator.add_regular({PulseAddress(1)}, 0, 0, 100), std::invalid_argument);
+}
+
+TEST(SpikeTrainGenerator, Bursts)
+{
+	SpikeTrainGenerator generator;
+	generator.add_bursts({PulseAddress(3)}, 1000, 3, 10, 0, 2005);
+
+	auto const spikes = generator.generate();
+	PulseEventContainer::container_type const expected = {
+		PulseEvent(PulseAddress(3), 0),    PulseEvent(PulseAddress(3), 10),
+		PulseEvent(PulseAddress(3), 20),   PulseEvent(PulseAddress(3), 1000),
+		PulseEvent(PulseAddress(3), 1010), PulseEvent(PulseAddress(3), 1020),
+		PulseEvent(PulseAddress(3), 2000)};
+	EXPECT_EQ(expected, spikes.data());
+}
+
+TEST(SpikeTrainGenerator, Poisson)
+{
+	SpikeTrainGenerator::addresses_type addresses;
+	for (PulseAddress::label_t label = 0; label < 100; ++label) {
+		addresses.push_back(PulseAddress(label));
+	}
+
+	// 10 kHz for 0.1 s (hardware time) yields 1000 spikes per address on average
+	SpikeTrainGenerator::spiketime_t const duration = DNC_frequency_in_MHz * 100000;
+	SpikeTrainGenerator generator(1234);
+	generator.add_poisson(addresses, 1e4, 500, 500 + duration);
+
+	auto const spikes = generator.generate();
+	EXPECT_TRUE(std::is_sorted(spikes.data().begin(), spikes.data().end()));
+	EXPECT_NEAR(100000, spikes.size(), 1500);
+	EXPECT_GE(spikes[0].getTime(), 500);
+	EXPECT_LT(spikes[spikes.size() - 1].getTime(), 500 + duration);
+
+	// coefficient of variation of inter-spike intervals is one
+	auto const times = spikes.times_of(42);
+	double sum = 0, sum_squares = 0;
+	for (size_t ii = 1; ii < times.size(); ++ii) {
+		double const isi = times[ii] - times[ii - 1];
+		sum += isi;
+		sum_squares += isi * isi;
+	}
+	double const mean = sum / (times.size() - 1);
+	double const variance = sum_squares / (times.size() - 1) - mean * mean;
+	EXPECT_NEAR(1., std::sqrt(variance) / mean, 0.1);
+
+	// deterministic for a given seed
+	SpikeTrainGenerator same(1234);
+	same.add_poisson(addresses, 1e4, 500, 500 + duration);
+	EXPECT_EQ(spikes.data(), same.generate().data());
+
+	EXPECT_THROW(generator.add_poisson(addresses, -1., 0, 100), std::invalid_argument);
+}
+
+TEST(SpikeTrainGenerator, ReleaseLimit)
+{
+	// four pulses released in the same FPGA cycle: the second and third are
+	// delayed by one and two cycles, the fourth would exceed max_delay = 2
+	SpikeTrainGenerator generator;
+	generator.add_regular({PulseAddress(1), PulseAddress(2), PulseAddress(3)}, 1000, 200, 1000);
+	generator.add_regular({PulseAddress(4)}, 1000, 201, 1000);
+	generator.set_release_limit(ReleaseLimit(40, 2));
+
+	size_t dropped_events;
+	auto const spikes = generator.generate(dropped_events);
+	EXPECT_EQ(1, dropped_events);
+	ASSERT_EQ(3, spikes.size());
+	EXPECT_EQ(PulseEvent(PulseAddress(1), 200), spikes[0]);
+	EXPECT_EQ(PulseEvent(PulseAddress(2), 200), spikes[1]);
+	EXPECT_EQ(PulseEvent(PulseAddress(3), 200), spikes[2]);
+
+	generator.clear_release_limit();
+	EXPECT_EQ(4, generator.generate(dropped_events).size());
+	EXPECT_EQ(0, dropped_events);
+
+	// pulses before 2 * fpga_hicann_delay can not be released
+	generator.set_release_limit(ReleaseLimit(200, 1));
+	EXPECT_THROW(generator.generate(), std::runtime_error);
+}
+
+} // namespace FPGA
+} // namespace HMF
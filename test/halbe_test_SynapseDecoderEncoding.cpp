@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "hal/backend/HICANNBackendHelper.h"
+
+using namespace HMF::HICANN;
+
+namespace HMF {
+
+namespace {
+
+typedef std::array<SynapseDecoder, 256> decoders_t;
+typedef std::array<std::bitset<32>, 32> words_t;
+
+// bitwise reference implementations, the encoding of the hardware
+
+/// top decoder row holds bits 2 and 3, bottom row bits 0 and 1 of the decoders
+words_t reference_to_decoder(decoders_t const& top, decoders_t const& bot, size_t const low)
+{
+	words_t returnvalue;
+	for (size_t i = 0; i < 32; i++) {
+		for (size_t j = 0; j < 8; j++) {
+			std::bitset<4> const ttop(top[8 * i + j]);
+			std::bitset<4> const tbot(bot[8 * i + j]);
+			returnvalue[i][31 - 4 * j] = tbot[low + 1];
+			returnvalue[i][31 - (4 * j + 1)] = ttop[low];
+			returnvalue[i][31 - (4 * j + 2)] = tbot[low];
+			returnvalue[i][31 - (4 * j + 3)] = ttop[low + 1];
+		}
+	}
+	return returnvalue;
+}
+
+/// @a lsb and @a msb are the positions of the two bits of a decoder within a 4-bit chunk
+decoders_t reference_from_decoder(
+	words_t const& top, words_t const& bot, size_t const lsb, size_t const msb)
+{
+	decoders_t returnvalue;
+	for (size_t i = 0; i < 256; i++) {
+		std::bitset<4> t;
+		t[0] = bot[i / 8][31 - (4 * (i % 8) + lsb)];
+		t[1] = bot[i / 8][31 - (4 * (i % 8) + msb)];
+		t[2] = top[i / 8][31 - (4 * (i % 8) + lsb)];
+		t[3] = top[i / 8][31 - (4 * (i % 8) + msb)];
+		returnvalue[i] = SynapseDecoder(t.to_ulong());
+	}
+	return returnvalue;
+}
+
+words_t reference_weights(WeightRow const& weights)
+{
+	words_t returnvalue;
+	for (size_t i = 0; i < 32; i++)
+		for (size_t j = 0; j < 8; j++)
+			for (size_t k = 0; k < 4; k++)
+				returnvalue[i][31 - 4 * j - k] = weights[8 * i + j].format()[3 - k];
+	return returnvalue;
+}
+
+template <typename T>
+std::array<T, 256> random_row(std::mt19937& rng)
+{
+	std::uniform_int_distribution<int> dist(0, 15);
+	std::array<T, 256> returnvalue;
+	for (auto& v : returnvalue)
+		v = T(dist(rng));
+	return returnvalue;
+}
+
+words_t random_words(std::mt19937& rng)
+{
+	words_t returnvalue;
+	for (auto& w : returnvalue)
+		w = rng();
+	return returnvalue;
+}
+
+} // namespace
+
+TEST(SynapseDecoderEncoding, MatchesReference)
+{
+	std::mt19937 rng(1234);
+	for (size_t n = 0; n < 100; n++) {
+		decoders_t const top = random_row<SynapseDecoder>(rng);
+		decoders_t const bot = random_row<SynapseDecoder>(rng);
+		ASSERT_EQ(reference_to_decoder(top, bot, 2), top_to_decoder(top, bot));
+		ASSERT_EQ(reference_to_decoder(top, bot, 0), bot_to_decoder(top, bot));
+
+		words_t const wtop = random_words(rng);
+		words_t const wbot = random_words(rng);
+		ASSERT_EQ(reference_from_decoder(wtop, wbot, 1, 3), top_from_decoder(wtop, wbot));
+		ASSERT_EQ(reference_from_decoder(wtop, wbot, 2, 0), bot_from_decoder(wtop, wbot));
+
+		// round trip
+		words_t const htop = top_to_decoder(top, bot);
+		words_t const hbot = bot_to_decoder(top, bot);
+		ASSERT_EQ(top, top_from_decoder(htop, hbot));
+		ASSERT_EQ(bot, bot_from_decoder(htop, hbot));
+	}
+}
+
+TEST(SynapseDecoderEncoding, Preouts)
+{
+	for (size_t p = 0; p < 256; p++) {
+		std::bitset<2> const p0(p), p1(p >> 2), p2(p >> 4), p3(p >> 6);
+		auto const hw = encode_preouts(p0, p1, p2, p3);
+		EXPECT_EQ(0, hw[0].to_ulong());
+		EXPECT_EQ(p0[0], hw[1][0]);
+		EXPECT_EQ(p1[1], hw[1][1]);
+		EXPECT_EQ(p0[1], hw[1][2]);
+		EXPECT_EQ(p1[0], hw[1][3]);
+		EXPECT_EQ(p2[0], hw[1][4]);
+		EXPECT_EQ(p3[1], hw[1][5]);
+		EXPECT_EQ(p2[1], hw[1][6]);
+		EXPECT_EQ(p3[0], hw[1][7]);
+
+		// [TOP/BOT][LEFT/RIGHT]
+		auto const decoded = decode_preouts(hw[1], hw[0]);
+		EXPECT_EQ(p0, decoded[1][0]);
+		EXPECT_EQ(p1, decoded[0][0]);
+		EXPECT_EQ(p2, decoded[1][1]);
+		EXPECT_EQ(p3, decoded[0][1]);
+	}
+}
+
+TEST(SynapseDecoderEncoding, Weights)
+{
+	std::mt19937 rng(4321);
+	for (size_t n = 0; n < 100; n++) {
+		WeightRow const weights(random_row<SynapseWeight>(rng));
+		words_t const hw = weights_to_sc_data(weights);
+		ASSERT_EQ(reference_weights(weights), hw);
+
+		// word 8 * i + colset is written to sc_synin + i, read back as 4 * colset + i
+		words_t readback;
+		for (size_t i = 0; i < 4; i++)
+			for (size_t colset = 0; colset < 8; colset++)
+				readback[4 * colset + i] = hw[8 * i + colset];
+		ASSERT_EQ(weights, weights_row_from_sc_data(readback));
+	}
+}
+
+} // namespace HMF
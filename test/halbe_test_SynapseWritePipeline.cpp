@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "hal/backend/HICANNBackendHelper.h"
+#include "hal/Coordinate/iter_all.h"
+
+using namespace HMF::HICANN;
+using namespace HMF::Coordinate;
+
+namespace HMF {
+
+namespace {
+
+/// Synapse controllers which are busy after each flush until waited for.
+struct SynapseControllerRecorder
+{
+	SynapseControllerRecorder() : busy{{false, false}}, waits(0), overlapping_writes(0) {}
+
+	static size_t queue(unsigned int const index)
+	{
+		return index == facets::HicannCtrl::SYNAPSE_TOP ? 0 : 1;
+	}
+
+	void write(sc_write_data const& instr)
+	{
+		size_t const q = queue(instr.index);
+		if (instr.type == sc_write_data::WRITEANDWAIT) {
+			EXPECT_FALSE(busy[q]) << "flush issued to busy controller";
+			busy[q] = true;
+		} else if (busy[q]) {
+			++overlapping_writes;
+		}
+		order.push_back(q);
+		written[q].push_back(instr);
+	}
+
+	void wait(unsigned int const index)
+	{
+		busy[queue(index)] = false;
+		++waits;
+	}
+
+	std::array<bool, 2> busy;
+	std::array<sc_write_data_queue_t, 2> written;
+	std::vector<size_t> order;
+	size_t waits;
+	size_t overlapping_writes;
+};
+
+bool operator==(sc_write_data const& a, sc_write_data const& b)
+{
+	return a.index == b.index && a.type == b.type && a.addr == b.addr && a.data == b.data;
+}
+
+} // namespace
+
+TEST(SynapseWritePipeline, WholeArray)
+{
+	sc_write_data_queues_t queues;
+	WeightRow weights;
+	for (auto row : iter_all<SynapseRowOnHICANN>()) {
+		for (size_t ii = 0; ii < weights.size(); ++ii)
+			weights[ii] = SynapseWeight((row.toEnum() + ii) % 16);
+		push_weights_row(row, weights, queues);
+	}
+
+	// 8 column sets of 4 data writes and a flush per row, half of the rows per controller
+	size_t const per_controller = SynapseRowOnHICANN::size / 2 * 8 * 5;
+	ASSERT_EQ(per_controller, queues[0].size());
+	ASSERT_EQ(per_controller, queues[1].size());
+	for (auto const& instr : queues[0])
+		EXPECT_EQ(facets::HicannCtrl::SYNAPSE_TOP, instr.index);
+	for (auto const& instr : queues[1])
+		EXPECT_EQ(facets::HicannCtrl::SYNAPSE_BOTTOM, instr.index);
+
+	SynapseControllerRecorder recorder;
+	pipeline_sc_write_data_queues(
+		queues, [&recorder](sc_write_data const& instr) { recorder.write(instr); },
+		[&recorder](unsigned int const index) { recorder.wait(index); });
+
+	// per controller order is unchanged
+	for (size_t q = 0; q < 2; ++q) {
+		ASSERT_EQ(queues[q].size(), recorder.written[q].size());
+		for (size_t ii = 0; ii < queues[q].size(); ++ii)
+			EXPECT_TRUE(queues[q][ii] == recorder.written[q][ii]) << q << " " << ii;
+	}
+
+	// each flush is waited for exactly once
+	EXPECT_EQ(SynapseRowOnHICANN::size * 8, recorder.waits);
+	EXPECT_FALSE(recorder.busy[0]);
+	EXPECT_FALSE(recorder.busy[1]);
+
+	// all but the first column set per controller are written during the previous flush
+	EXPECT_EQ(2 * (per_controller / 5 - 1) * 4, recorder.overlapping_writes);
+
+	// controllers are interleaved column set-wise
+	for (size_t ii = 0; ii + 5 < 2 * 5 * 8; ii += 5)
+		EXPECT_NE(recorder.order[ii], recorder.order[ii + 5]);
+}
+
+TEST(SynapseWritePipeline, UnevenQueues)
+{
+	sc_write_data_queues_t queues;
+	push_weights_row(SynapseRowOnHICANN(Enum(0)), WeightRow(), queues);
+	ASSERT_TRUE(queues[1].empty());
+
+	SynapseControllerRecorder recorder;
+	pipeline_sc_write_data_queues(
+		queues, [&recorder](sc_write_data const& instr) { recorder.write(instr); },
+		[&recorder](unsigned int const index) { recorder.wait(index); });
+
+	EXPECT_EQ(queues[0].size(), recorder.written[0].size());
+	EXPECT_TRUE(recorder.written[1].empty());
+	EXPECT_EQ(8, recorder.waits);
+	EXPECT_FALSE(recorder.busy[0]);
+}
+
+} // namespace HMF
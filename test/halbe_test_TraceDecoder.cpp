@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "hal/backend/TraceDecoder.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+typedef std::vector<std::uint64_t> packet_type;
+
+std::uint64_t word(std::uint32_t const lower, std::uint32_t const upper)
+{
+	return (static_cast<std::uint64_t>(upper) << 32) | lower;
+}
+
+std::uint32_t pulse(std::uint32_t const label, std::uint32_t const timestamp, bool const fpga_msb)
+{
+	return (static_cast<std::uint32_t>(fpga_msb) << 29) | (label << 15) | timestamp;
+}
+
+std::uint32_t overflow(std::uint32_t const count)
+{
+	return (1u << 31) | count;
+}
+
+/// Random trace packets, including garbage and misplaced overflow indicators.
+std::vector<packet_type> generate_corpus(size_t const seed)
+{
+	std::mt19937_64 rng(seed);
+	std::vector<packet_type> corpus(1 + rng() % 32);
+	std::uint32_t overflow_count = 0;
+	for (auto& packet : corpus) {
+		packet.resize(rng() % 180);
+		for (auto& w : packet) {
+			std::uint32_t entries[2];
+			for (size_t ii = 0; ii < 2; ++ii) {
+				size_t const type = rng() % 100;
+				if (type < 5 && ii == 1)
+					entries[ii] = overflow(++overflow_count);
+				else if (type < 5 && seed % 3 == 0)
+					// misplaced overflow indicator, ignored by the decoder
+					entries[ii] = overflow(overflow_count + 1);
+				else if (type < 10)
+					entries[ii] = (1u << 30) | (rng() & 0x3fffffff);
+				else
+					entries[ii] = rng() & 0x3fffffff;
+				// background events
+				if (rng() % 4 == 0)
+					entries[ii] &= ~(0x3fu << 15);
+			}
+			w = word(entries[0], entries[1]);
+		}
+	}
+	auto& last = corpus.back();
+	last.push_back(TraceDecoder::end_of_trace_marker);
+	return corpus;
+}
+
+struct DecodeResult
+{
+	AlmostSortedPulseEvents::container_type events;
+	std::vector<std::uint64_t> received;
+	bool received_eot;
+	size_t dropped_events;
+	std::uint64_t overflow_count;
+};
+
+DecodeResult decode(
+	std::vector<packet_type> const& corpus,
+	TraceEventFilter const& filter,
+	TraceDecoder::Implementation const implementation)
+{
+	TraceDecoder decoder(Coordinate::FPGAGlobal(), filter, implementation);
+	DecodeResult result;
+	result.received_eot = false;
+	for (auto const& packet : corpus) {
+		result.received_eot = decoder.decode(packet.data(), packet.size());
+		result.events.insert(
+			result.events.end(), decoder.events().begin(), decoder.events().end());
+		result.received.push_back(decoder.received_events());
+		if (result.received_eot)
+			break;
+	}
+	result.dropped_events = decoder.dropped_events();
+	result.overflow_count = decoder.overflow_count();
+	return result;
+}
+
+} // namespace
+
+TEST(TraceDecoder, Reference)
+{
+	std::vector<packet_type> corpus;
+	corpus.push_back({word(pulse(0x123, 5, false), pulse(0x040, 0x7000, false)),
+	                  word(pulse(0x001, 10, false), overflow(1))});
+	corpus.push_back({word(pulse(0x002, 0x7001, false), pulse(0x003, 1, true)),
+	                  word(pulse(0x040, 2, true), 0x40000000),
+	                  TraceDecoder::end_of_trace_marker});
+
+	TraceDecoder decoder(Coordinate::FPGAGlobal(), true, TraceDecoder::Implementation::reference);
+
+	EXPECT_FALSE(decoder.decode(corpus[0].data(), corpus[0].size()));
+	// early pulse with 0x7000 is ignored
+	EXPECT_EQ(2, decoder.received_events());
+	ASSERT_EQ(2, decoder.events().size());
+	EXPECT_EQ(PulseEvent(PulseAddress(0x123), 5), decoder.events()[0]);
+	EXPECT_EQ(PulseEvent(PulseAddress(0x001), 10), decoder.events()[1]);
+	EXPECT_EQ(1, decoder.overflow_count());
+
+	EXPECT_TRUE(decoder.decode(corpus[1].data(), corpus[1].size()));
+	EXPECT_EQ(3, decoder.received_events());
+	// pulse registered before the overflow
+	ASSERT_EQ(2, decoder.events().size());
+	EXPECT_EQ(PulseEvent(PulseAddress(0x002), 0x7001), decoder.events()[0]);
+	EXPECT_EQ(PulseEvent(PulseAddress(0x003), 0x8001), decoder.events()[1]);
+	// background event with L1 address zero
+	EXPECT_EQ(1, decoder.dropped_events());
+}
+
+TEST(TraceDecoder, AVX2BitExact)
+{
+	if (!TraceDecoder::avx2_supported())
+		return;
+
+	std::vector<TraceEventFilter> filters(4);
+	filters[1].drop_background_events();
+	filters[2].deny_all_labels();
+	for (PulseAddress::label_t label = 0; label < PulseAddress::num_labels; label += 7)
+		filters[2].set_label_allowed(label, true);
+	filters[2].set_link_selected(
+		PulseAddress::chip_address_t(Coordinate::Enum(3)),
+		PulseAddress::channel_t(Coordinate::Enum(1)), false);
+	filters[3].set_time_window(0x4000, 0x30000);
+
+	for (size_t seed = 0; seed < 500; ++seed) {
+		auto const corpus = generate_corpus(seed);
+		for (auto const& filter : filters) {
+			auto const reference =
+				decode(corpus, filter, TraceDecoder::Implementation::reference);
+			auto const avx2 = decode(corpus, filter, TraceDecoder::Implementation::avx2);
+
+			ASSERT_EQ(reference.events, avx2.events) << "seed " << seed;
+			ASSERT_EQ(reference.received, avx2.received) << "seed " << seed;
+			ASSERT_EQ(reference.received_eot, avx2.received_eot) << "seed " << seed;
+			ASSERT_EQ(reference.dropped_events, avx2.dropped_events) << "seed " << seed;
+			ASSERT_EQ(reference.overflow_count, avx2.overflow_count) << "seed " << seed;
+		}
+	}
+}
+
+TEST(TraceDecoder, Filter)
+{
+	std::vector<packet_type> corpus;
+	corpus.push_back({word(pulse(0x123, 5, false), pulse(0x040, 0x7000, false)),
+	                  word(pulse(0x001, 10, false), overflow(1)),
+	                  word(pulse(0x241, 0x7001, false), pulse(0x003, 1, true)),
+	                  TraceDecoder::end_of_trace_marker});
+
+	auto const all = decode(corpus, TraceEventFilter(), TraceDecoder::Implementation::reference);
+	ASSERT_EQ(4, all.events.size());
+	EXPECT_EQ(0, all.dropped_events);
+
+	TraceEventFilter labels;
+	labels.deny_all_labels();
+	labels.set_label_allowed(0x123, true);
+	labels.set_label_allowed(0x003, true);
+	auto const by_label = decode(corpus, labels, TraceDecoder::Implementation::reference);
+	ASSERT_EQ(2, by_label.events.size());
+	EXPECT_EQ(PulseEvent(PulseAddress(0x123), 5), by_label.events[0]);
+	EXPECT_EQ(PulseEvent(PulseAddress(0x003), 0x8001), by_label.events[1]);
+	EXPECT_EQ(2, by_label.dropped_events);
+
+	TraceEventFilter window;
+	window.set_time_window(6, 0x8001);
+	auto const by_time = decode(corpus, window, TraceDecoder::Implementation::reference);
+	ASSERT_EQ(2, by_time.events.size());
+	EXPECT_EQ(PulseEvent(PulseAddress(0x001), 10), by_time.events[0]);
+	EXPECT_EQ(PulseEvent(PulseAddress(0x241), 0x7001), by_time.events[1]);
+	EXPECT_EQ(2, by_time.dropped_events);
+
+	TraceEventFilter link;
+	PulseAddress const address(0x241);
+	link.set_link_selected(address.getChipAddress(), address.getChannel(), false);
+	EXPECT_FALSE(link.is_link_selected(address.getChipAddress(), address.getChannel()));
+	// same HICANN, other Gbit link
+	EXPECT_TRUE(link.is_link_selected(address.getChipAddress(), PulseAddress(0x201).getChannel()));
+	auto const by_link = decode(corpus, link, TraceDecoder::Implementation::reference);
+	EXPECT_EQ(3, by_link.events.size());
+	EXPECT_EQ(1, by_link.dropped_events);
+}
+
+} // namespace FPGA
+} // namespace HMF
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "hal/FPGA/TraceReducers.h"
+
+namespace HMF {
+namespace FPGA {
+
+namespace {
+
+TracePulseReducer::container_type generate_events()
+{
+	std::mt19937 rng(1234);
+	TracePulseReducer::container_type events;
+	for (size_t ii = 0; ii < 20000; ++ii) {
+		events.push_back(PulseEvent(PulseAddress(rng() % 300), rng() % 100000));
+	}
+	return events;
+}
+
+} // namespace
+
+TEST(TraceReducers, SpikeCounter)
+{
+	auto const events = generate_events();
+	SpikeCounter counter;
+	// in chunks, as during the trace readout
+	counter.reduce(events.data(), events.data() + 5000);
+	counter.reduce(events.data() + 5000, events.data() + events.size());
+
+	EXPECT_EQ(events.size(), counter.total());
+	ASSERT_EQ(PulseAddress::num_labels, counter.counts().size());
+	for (PulseAddress::label_t label : {0, 17, 299, 300, 0x3fff}) {
+		EXPECT_EQ(
+			std::count_if(
+				events.begin(), events.end(),
+				[label](PulseEvent const& event) { return event.getLabel() == label; }),
+			counter.count(label));
+	}
+
+	// labels beyond 14 bit are masked, as for the label index of PulseEventContainer
+	SpikeCounter masked;
+	PulseEvent const invalid(PulseAddress(0xffff), 1);
+	masked.reduce(&invalid, &invalid + 1);
+	EXPECT_EQ(1, masked.count(0x3fff));
+	// but rejected by the accessors
+	EXPECT_THROW(masked.count(0x4000), std::out_of_range);
+	EXPECT_THROW(masked.count(0xffff), std::out_of_range);
+}
+
+TEST(TraceReducers, BinnedSpikeCounter)
+{
+	EXPECT_THROW(BinnedSpikeCounter(0, 10), std::invalid_argument);
+	EXPECT_THROW(BinnedSpikeCounter(10, 0), std::invalid_argument);
+
+	auto const events = generate_events();
+	BinnedSpikeCounter counter(2500, 20, 40000);
+	counter.reduce(events);
+
+	std::uint64_t in_range = 0;
+	for (PulseAddress::label_t label = 0; label < 300; ++label) {
+		for (size_t bin = 0; bin < counter.num_bins(); ++bin) {
+			auto const expected = std::count_if(
+				events.begin(), events.end(), [label, bin](PulseEvent const& event) {
+					return event.getLabel() == label && event.getTime() >= 40000 + bin * 2500 &&
+					       event.getTime() < 40000 + (bin + 1) * 2500;
+				});
+			ASSERT_EQ(expected, counter.count(label, bin));
+			in_range += expected;
+		}
+	}
+	EXPECT_EQ(events.size() - in_range, counter.out_of_range());
+
+	// 250 MHz DNC clock: 2500 cycles are 10 us
+	EXPECT_DOUBLE_EQ(counter.count(17, 3) * 1e5, counter.rate(17, 3));
+
+	EXPECT_THROW(counter.count(0x4000, 0), std::out_of_range);
+	EXPECT_THROW(counter.count(17, counter.num_bins()), std::out_of_range);
+}
+
+TEST(TraceReducers, FirstLastSpikeTimes)
+{
+	auto const events = generate_events();
+	FirstLastSpikeTimes times;
+	times.reduce(events);
+
+	EXPECT_FALSE(times.has_spikes(300));
+	EXPECT_THROW(times.has_spikes(0x4000), std::out_of_range);
+	EXPECT_THROW(times.first(0xffff), std::out_of_range);
+	EXPECT_THROW(times.last(0x4000), std::out_of_range);
+
+	// labels beyond 14 bit are masked on reduction
+	FirstLastSpikeTimes masked;
+	PulseEvent const invalid(PulseAddress(0x7fff), 42);
+	masked.reduce(&invalid, &invalid + 1);
+	EXPECT_TRUE(masked.has_spikes(0x3fff));
+	EXPECT_EQ(42, masked.first(0x3fff));
+	for (PulseAddress::label_t label : {0, 17, 299}) {
+		PulseEventContainer::container_type of_label;
+		std::copy_if(
+			events.begin(), events.end(), std::back_inserter(of_label),
+			[label](PulseEvent const& event) { return event.getLabel() == label; });
+		ASSERT_TRUE(times.has_spikes(label));
+		EXPECT_EQ(std::min_element(of_label.begin(), of_label.end())->getTime(), times.first(label));
+		EXPECT_EQ(std::max_element(of_label.begin(), of_label.end())->getTime(), times.last(label));
+	}
+}
+
+} // namespace FPGA
+} // namespace HMF